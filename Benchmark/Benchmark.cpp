@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <random>
+#include "DepthFirst.h"
+#include "BreadthFirst.h"
+#include "Dijkstra.h"
+#include "AStar.h"
+#include "BidirectionalDijkstra.h"
+#include "BidirectionalAStar.h"
+#include "JumpPointSearchPlus.h"
+#include "HierarchicalAStar.h"
+#include "ContractionHierarchySearch.h"
+#include "Landmarks.h"
+#include "DeltaStepping.h"
+#include "ManyToMany.h"
+#include "DStarLite.h"
+#include "QueryService.h"
+#include "BatchScheduler.h"
+#include "GraphSnapshots.h"
+#include "GridGraphBuilder.h"
+
+using namespace Pathfinding;
+
+struct BenchmarkOptions
+{
+    int width = 256;
+    int height = 256;
+    int queries = 1000;
+    unsigned int seed = 0;
+    bool compact = false;
+    bool implicit = false;
+    bool contract = false;
+    int threads = 0;
+    int table = 0;
+    int replan = 0;
+};
+
+struct Query
+{
+    uint32_t start;
+    uint32_t end;
+};
+
+static bool parseOptions(int argc, char* argv[], BenchmarkOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--width" && hasValue) options.width = std::stoi(argv[++i]);
+        else if (argument == "--height" && hasValue) options.height = std::stoi(argv[++i]);
+        else if (argument == "--queries" && hasValue) options.queries = std::stoi(argv[++i]);
+        else if (argument == "--seed" && hasValue) options.seed = (unsigned int)std::stoul(argv[++i]);
+        else if (argument == "--compact") options.compact = true;
+        else if (argument == "--implicit") options.implicit = true;
+        else if (argument == "--contract") options.contract = true;
+        else if (argument == "--threads" && hasValue) options.threads = std::stoi(argv[++i]);
+        else if (argument == "--table" && hasValue) options.table = std::stoi(argv[++i]);
+        else if (argument == "--replan" && hasValue) options.replan = std::stoi(argv[++i]);
+        else return false;
+    }
+
+    return options.width > 0 && options.height > 0 && options.queries > 0 && options.threads >= 0 && options.table >= 0 && options.replan >= 0;
+}
+
+static std::chrono::nanoseconds percentile(const std::vector<std::chrono::nanoseconds>& sortedLatencies, const double fraction)
+{
+    const size_t rank = (size_t)std::ceil(fraction * sortedLatencies.size());
+    return sortedLatencies[rank > 0 ? rank - 1 : 0];
+}
+
+static bool isSameWeight(const float weight, const float reference)
+{
+    // missing paths have infinite weight, sums in another order may differ in the last bits
+    return weight == reference || std::abs(weight - reference) <= 1e-4f * std::max(1.0f, reference);
+}
+
+// exact searches have to find the path weights Dijkstra found, returns the number of queries that disagree
+static size_t verifyWeights(const std::string& name, const std::vector<float>& weights, const std::vector<float>& reference)
+{
+    size_t mismatches = 0;
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        if (!isSameWeight(weights[i], reference[i])) mismatches++;
+    }
+
+    if (mismatches > 0) std::cerr << std::format("{} disagrees with Dijkstra on {} of {} queries\n", name, mismatches, weights.size());
+    return mismatches;
+}
+
+// run is called once per query and has to return its SearchResult, returns the path weight per query, infinite if no path was found
+template<typename Run>
+static std::vector<float> runBenchmark(const std::string& name, const std::vector<Query>& queries, const Run& run)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    SearchWorkspace workspace;
+    vector<nanoseconds> latencies;
+    latencies.reserve(queries.size());
+    vector<float> weights;
+    weights.reserve(queries.size());
+    size_t pathsFound = 0;
+    size_t nodesExplored = 0;
+
+    const auto startTime = high_resolution_clock().now();
+    for (const Query& query : queries)
+    {
+        const SearchResult result = run(query, workspace);
+
+        latencies.push_back(result.runtime);
+        weights.push_back(result.pathFound ? result.pathWeight : numeric_limits<float>::infinity());
+        nodesExplored += result.nodesExplored;
+        if (result.pathFound) pathsFound++;
+    }
+    const duration<double> wallTime = high_resolution_clock().now() - startTime;
+
+    sort(latencies.begin(), latencies.end());
+    const double throughput = queries.size() / wallTime.count();
+    const double p50 = duration<double, micro>(percentile(latencies, 0.50)).count();
+    const double p99 = duration<double, micro>(percentile(latencies, 0.99)).count();
+    const double averageExplored = (double)nodesExplored / queries.size();
+
+    cout << format("{:<14}{:>10}{:>10}{:>16.1f}{:>12.1f}{:>12.1f}{:>16.1f}\n", name, queries.size(), pathsFound, throughput, p50, p99, averageExplored);
+    return weights;
+}
+
+// one-to-all searches from the start of the first queries, run is called once per source and has to return the number of reached nodes
+template<typename Run>
+static void runFieldBenchmark(const std::string& name, const std::vector<Query>& queries, const Run& run)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const size_t sourceCount = min<size_t>(queries.size(), 20);
+    vector<nanoseconds> latencies;
+    size_t nodesReached = 0;
+
+    for (size_t i = 0; i < sourceCount; i++)
+    {
+        const auto startTime = high_resolution_clock().now();
+        nodesReached += run(queries[i].start);
+        latencies.push_back(high_resolution_clock().now() - startTime);
+    }
+
+    sort(latencies.begin(), latencies.end());
+    const double p50 = duration<double, milli>(percentile(latencies, 0.50)).count();
+    const double p99 = duration<double, milli>(percentile(latencies, 0.99)).count();
+    const double averageReached = (double)nodesReached / sourceCount;
+
+    cout << format("{:<14}{:>10}{:>12.2f}{:>12.2f}{:>16.1f}\n", name, sourceCount, p50, p99, averageReached);
+}
+
+static size_t countReached(const DistanceField& field)
+{
+    return std::count_if(field.distances.begin(), field.distances.end(), [](const float distance) { return distance != std::numeric_limits<float>::infinity(); });
+}
+
+static void runFieldBenchmarks(const DeltaStepping& deltaStepping, const std::string& name, const Graph* graph, const CompactGraph* compactGraph, const ImplicitGridGraph* implicitGraph, const std::vector<Query>& queries)
+{
+    if (implicitGraph) runFieldBenchmark(name, queries, [&](const uint32_t source) { return countReached(deltaStepping.run(*implicitGraph, source)); });
+    else if (compactGraph) runFieldBenchmark(name, queries, [&](const uint32_t source) { return countReached(deltaStepping.run(*compactGraph, *compactGraph->nodeAt(source))); });
+    else runFieldBenchmark(name, queries, [&](const uint32_t source) { return countReached(deltaStepping.run(*graph, *graph->nodeAt(source))); });
+}
+
+// the field and the workspace are shared between all sources, like a caller running many bounded searches would
+static void runFieldBenchmarks(const Dijkstra& dijkstra, const std::string& name, const Graph* graph, const CompactGraph* compactGraph, const ImplicitGridGraph* implicitGraph, const std::vector<Query>& queries)
+{
+    SearchWorkspace workspace;
+    std::vector<SettledNode> field;
+    if (implicitGraph) runFieldBenchmark(name, queries, [&](const uint32_t source) { dijkstra.runField(*implicitGraph, source, workspace, field); return field.size(); });
+    else if (compactGraph) runFieldBenchmark(name, queries, [&](const uint32_t source) { dijkstra.runField(*compactGraph, *compactGraph->nodeAt(source), workspace, field); return field.size(); });
+    else runFieldBenchmark(name, queries, [&](const uint32_t source) { dijkstra.runField(*graph, *graph->nodeAt(source), workspace, field); return field.size(); });
+}
+
+static std::vector<float> runBenchmarks(const Pathfinder& pathfinder, const std::string& name, const Graph* graph, const CompactGraph* compactGraph, const ImplicitGridGraph* implicitGraph, const std::vector<Query>& queries)
+{
+    if (implicitGraph) return runBenchmark(name, queries, [&](const Query& query, SearchWorkspace& workspace) { return pathfinder.runSync(*implicitGraph, query.start, query.end, workspace); });
+    else if (compactGraph) return runBenchmark(name, queries, [&](const Query& query, SearchWorkspace& workspace) { return pathfinder.runSync(*compactGraph, *compactGraph->nodeAt(query.start), *compactGraph->nodeAt(query.end), workspace); });
+    else return runBenchmark(name, queries, [&](const Query& query, SearchWorkspace& workspace) { return pathfinder.runSync(*graph, *graph->nodeAt(query.start), *graph->nodeAt(query.end), workspace); });
+}
+
+// the same queries answered as one batch by a pool of workers sharing the graph
+static void runServiceBenchmark(const Pathfinder& pathfinder, const std::string& name, const size_t threadCount, const Graph* graph, const CompactGraph* compactGraph, const ImplicitGridGraph* implicitGraph, const std::vector<Query>& queries)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const unique_ptr<QueryService> service = implicitGraph ? make_unique<QueryService>(pathfinder, *implicitGraph, threadCount)
+        : compactGraph ? make_unique<QueryService>(pathfinder, *compactGraph, threadCount) : make_unique<QueryService>(pathfinder, *graph, threadCount);
+
+    vector<PathQuery> pathQueries;
+    for (const Query& query : queries) pathQueries.push_back({ query.start, query.end });
+
+    const auto startTime = high_resolution_clock().now();
+    const vector<SearchResult> results = service->runBatch(pathQueries);
+    const duration<double> wallTime = high_resolution_clock().now() - startTime;
+
+    const size_t pathsFound = count_if(results.begin(), results.end(), [](const SearchResult& result) { return result.pathFound; });
+    cout << format("{:<14}{:>10}{:>10}{:>16.1f}\n", name, service->getThreadCount(), pathsFound, queries.size() / wallTime.count());
+}
+
+// the same batch while a writer keeps raising random edge weights, raised weights keep the heuristic admissible
+// every query searches the version that was newest when it started, none of them waits for the writer to build a version
+// the writer raises weights by less than twice their weight in the graph, so every answer lies between the reference weight and twice of it
+// afterwards the exact searches run on the last version and have to agree with Dijkstra on it, returns the number of queries that disagree
+static size_t runSnapshotBenchmark(const Pathfinder& pathfinder, const std::string& name, const size_t threadCount, const Graph& graph, const std::vector<Query>& queries, const std::vector<float>& reference, const std::vector<std::pair<std::string, const Pathfinder*>>& exactPathfinders)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    GraphSnapshots snapshots(graph);
+    QueryService service(pathfinder, snapshots, threadCount);
+
+    vector<PathQuery> pathQueries;
+    for (const Query& query : queries) pathQueries.push_back({ query.start, query.end });
+
+    jthread writer([&snapshots, &graph](stop_token stopToken)
+    {
+        mt19937 random(0);
+        uniform_int_distribution<uint32_t> nodeDistribution(0, (uint32_t)graph.getIndexCount() - 1);
+        uniform_real_distribution<float> factorDistribution(1, 2);
+        while (!stopToken.stop_requested())
+        {
+            vector<EdgeUpdate> updates;
+            for (int i = 0; i < 64; i++)
+            {
+                const Node* node = graph.nodeAt(nodeDistribution(random));
+                if (!node || node->getEdges().empty()) continue;
+
+                const auto& edge = node->getEdges().front();
+                updates.push_back({ node->getIndex(), edge.neighbour->getIndex(), edge.weight * factorDistribution(random) });
+            }
+            snapshots.update(updates);
+        }
+    });
+
+    const auto startTime = high_resolution_clock().now();
+    const vector<SearchResult> results = service.runBatch(pathQueries);
+    const duration<double> wallTime = high_resolution_clock().now() - startTime;
+    writer.request_stop();
+    writer.join();
+
+    const size_t pathsFound = count_if(results.begin(), results.end(), [](const SearchResult& result) { return result.pathFound; });
+    cout << format("{:<14}{:>10}{:>10}{:>16.1f}{:>12}\n", name, service.getThreadCount(), pathsFound, queries.size() / wallTime.count(), snapshots.getVersion());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        const float weight = results[i].pathFound ? results[i].pathWeight : numeric_limits<float>::infinity();
+        if (!(isSameWeight(weight, reference[i]) || (weight > reference[i] && weight <= 2 * reference[i]))) mismatches++;
+    }
+    if (mismatches > 0) cerr << format("{} lies outside of the weights of its versions on {} of {} queries\n", name, mismatches, queries.size());
+
+    const shared_ptr<const CompactGraph> last = snapshots.pin();
+    auto runOnLast = [&](const Pathfinder& pathfinder)
+    {
+        SearchWorkspace workspace;
+        vector<float> weights;
+        for (const Query& query : queries)
+        {
+            const SearchResult result = pathfinder.runSync(*last, *last->nodeAt(query.start), *last->nodeAt(query.end), workspace);
+            weights.push_back(result.pathFound ? result.pathWeight : numeric_limits<float>::infinity());
+        }
+        return weights;
+    };
+
+    const vector<float> lastReference = runOnLast(Dijkstra());
+    for (const auto& [exactName, exactPathfinder] : exactPathfinders) mismatches += verifyWeights(format("{} on version {}", exactName, last->getSnapshotVersion()), runOnLast(*exactPathfinder), lastReference);
+    return mismatches;
+}
+
+// one batch mixing several algorithms, every worker reports how much of the batch it spent searching
+static void runSchedulerBenchmark(const std::vector<const Pathfinder*>& pathfinders, const size_t threadCount, const Graph* graph, const CompactGraph* compactGraph, const ImplicitGridGraph* implicitGraph, const std::vector<Query>& queries)
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    const unique_ptr<BatchScheduler> scheduler = implicitGraph ? make_unique<BatchScheduler>(*implicitGraph, threadCount)
+        : compactGraph ? make_unique<BatchScheduler>(*compactGraph, threadCount) : make_unique<BatchScheduler>(*graph, threadCount);
+
+    vector<BatchJob> jobs;
+    for (size_t i = 0; i < queries.size(); i++) jobs.push_back({ pathfinders[i % pathfinders.size()], queries[i].start, queries[i].end });
+
+    const BatchResult batch = scheduler->run(jobs);
+
+    cout << format("\n{:<14}{:>10}{:>10}{:>12}{:>14}\n", "batch worker", "jobs", "steals", "busy [ms]", "utilisation");
+    for (size_t worker = 0; worker < batch.workers.size(); worker++)
+    {
+        const WorkerStatistics& statistics = batch.workers[worker];
+        cout << format("{:<14}{:>10}{:>10}{:>12.1f}{:>13.1f}%\n", worker, statistics.jobsRun, statistics.steals, duration<double, milli>(statistics.busyTime).count(), statistics.utilisation * 100);
+    }
+    cout << format("{:<14}{:>10}{:>10}{:>12.1f}\n", "batch", jobs.size(), "", duration<double, milli>(batch.runtime).count());
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        cerr << "Usage: Benchmark [--width N] [--height N] [--queries N] [--seed N] [--compact | --implicit] [--contract] [--threads N] [--table N] [--replan N]\n";
+        return -1;
+    }
+
+    // implicit grids are searched without ever materialising the pointer graph
+    const auto buildStart = high_resolution_clock().now();
+    const GridGraphBuilder builder(options.width, options.height, options.seed);
+    shared_ptr<Graph> graph;
+    unique_ptr<CompactGraph> compactGraph;
+    shared_ptr<const ImplicitGridGraph> implicitGraph, layout;
+    if (options.implicit) implicitGraph = layout = builder.buildImplicit();
+    else
+    {
+        const shared_ptr<GridGraph> gridGraph = builder.build();
+        graph = gridGraph->graph;
+        layout = gridGraph->layout;
+    }
+    if (options.compact && graph) compactGraph = make_unique<CompactGraph>(*graph);
+    const duration<double, milli> buildTime = high_resolution_clock().now() - buildStart;
+
+    const size_t indexCount = implicitGraph ? implicitGraph->getIndexCount() : graph->getIndexCount();
+    const string graphType = implicitGraph ? "implicit" : compactGraph ? "compact" : "pointer";
+    cout << format("Grid {}x{}, {} nodes, seed {}, {} graph built in {:.1f}ms\n\n", options.width, options.height, indexCount, options.seed, graphType, buildTime.count());
+
+    // every algorithm answers the same queries
+    mt19937 random(options.seed);
+    uniform_int_distribution<uint32_t> nodeDistribution(0, (uint32_t)indexCount - 1);
+    vector<Query> queries;
+    queries.reserve(options.queries);
+    for (int i = 0; i < options.queries; i++)
+    {
+        queries.push_back({ nodeDistribution(random), nodeDistribution(random) });
+    }
+
+    const int height = options.height;
+    const auto heuristic = [height](const Graph&, const Node& current, const Node& target)
+    {
+        // Manhattan Distance, nodes were added column by column
+        const int currentX = current.getIndex() / height, currentY = current.getIndex() % height;
+        const int targetX = target.getIndex() / height, targetY = target.getIndex() % height;
+        return (float)(abs(targetX - currentX) + abs(targetY - currentY));
+    };
+
+    AStar aStar;
+    aStar.getHeuristic = heuristic;
+    BidirectionalDijkstra bidirectionalDijkstra;
+    BidirectionalAStar bidirectionalAStar;
+    bidirectionalAStar.getHeuristic = heuristic;
+    if (graph)
+    {
+        // built once up front, so no query pays for the reverse graph
+        bidirectionalDijkstra.prepareReverseGraph(*graph);
+        bidirectionalAStar.prepareReverseGraph(*graph);
+    }
+    JumpPointSearch jumpPointSearch;
+    jumpPointSearch.setLayout(layout);
+    JumpPointSearchPlus jumpPointSearchPlus;
+    jumpPointSearchPlus.setLayout(layout);
+    HierarchicalAStar hierarchicalAStar;
+    hierarchicalAStar.setLayout(layout);
+    DStarLite dStarLite;
+    dStarLite.setLayout(layout);
+
+    // implicit searches use the grid's own distance estimate, so landmark heuristics only apply to pointer and compact graphs
+    unique_ptr<Landmarks> landmarks;
+    AStar landmarkAStar;
+    if (graph)
+    {
+        landmarks = make_unique<Landmarks>(*graph);
+        const duration<double, milli> landmarkTime = landmarks->getPreprocessingTime();
+        cout << format("{} landmarks selected in {:.1f}ms\n\n", landmarks->getLandmarks().size(), landmarkTime.count());
+        landmarkAStar.getHeuristic = landmarks->getHeuristic();
+    }
+
+    // contracting takes far longer than any other preprocessing, so it only runs when asked for
+    ContractionHierarchySearch contractionHierarchySearch;
+    if (options.contract)
+    {
+        const shared_ptr<const ContractionHierarchy> hierarchy = implicitGraph ? make_shared<ContractionHierarchy>(*implicitGraph) : make_shared<ContractionHierarchy>(*graph);
+        const duration<double, milli> contractionTime = hierarchy->getPreprocessingTime();
+        cout << format("Contraction hierarchy built in {:.1f}ms, {} edges of which {} shortcuts, {:.1f}KiB\n\n", contractionTime.count(), hierarchy->getEdgeCount(), hierarchy->getShortcutCount(), hierarchy->getMemoryUsage() / 1024.0);
+        contractionHierarchySearch.setHierarchy(hierarchy);
+    }
+
+    cout << format("{:<14}{:>10}{:>10}{:>16}{:>12}{:>12}{:>16}\n", "algorithm", "queries", "found", "queries/s", "p50 [us]", "p99 [us]", "avg expanded");
+    runBenchmarks(DepthFirst(), "DepthFirst", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    runBenchmarks(BreadthFirst(), "BreadthFirst", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    const vector<float> reference = runBenchmarks(Dijkstra(), "Dijkstra", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+
+    // every exact search has to find the weights Dijkstra found, HPA* and the unweighted searches only find some path
+    size_t mismatches = 0;
+    mismatches += verifyWeights("AStar", runBenchmarks(aStar, "AStar", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    mismatches += verifyWeights("BiDijkstra", runBenchmarks(bidirectionalDijkstra, "BiDijkstra", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    mismatches += verifyWeights("BiAStar", runBenchmarks(bidirectionalAStar, "BiAStar", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    if (landmarks) mismatches += verifyWeights("ALT", runBenchmarks(landmarkAStar, "ALT", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    mismatches += verifyWeights("JPS", runBenchmarks(jumpPointSearch, "JPS", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    mismatches += verifyWeights("JPS+", runBenchmarks(jumpPointSearchPlus, "JPS+", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    runBenchmarks(hierarchicalAStar, "HPA*", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    mismatches += verifyWeights("D* Lite", runBenchmarks(dStarLite, "D* Lite", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+    if (options.contract) mismatches += verifyWeights("CH", runBenchmarks(contractionHierarchySearch, "CH", graph.get(), compactGraph.get(), implicitGraph.get(), queries), reference);
+
+    cout << format("\n{:<14}{:>10}{:>10}{:>16}{:>12}\n", "concurrent", "threads", "found", "queries/s", "versions");
+    runServiceBenchmark(aStar, "AStar", 1, graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    runServiceBenchmark(aStar, "AStar", (size_t)options.threads, graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    if (graph) mismatches += runSnapshotBenchmark(aStar, "AStar live", (size_t)options.threads, *graph, queries, reference, { { "AStar", &aStar }, { "BiDijkstra", &bidirectionalDijkstra }, { "BiAStar", &bidirectionalAStar } });
+
+    const Dijkstra dijkstra;
+    runSchedulerBenchmark({ &dijkstra, &aStar, &jumpPointSearchPlus }, (size_t)options.threads, graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+
+    // one-to-all distance fields, sequential Dijkstra against delta-stepping on a single and on all threads
+    const DeltaStepping parallelDeltaStepping((size_t)options.threads);
+    cout << format("\n{:<14}{:>10}{:>12}{:>12}{:>16}\n", "one-to-all", "sources", "p50 [ms]", "p99 [ms]", "avg reached");
+    runFieldBenchmarks(Dijkstra(), "Dijkstra", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    runFieldBenchmarks(DeltaStepping(1), "DeltaStep x1", graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+    runFieldBenchmarks(parallelDeltaStepping, format("DeltaStep x{}", parallelDeltaStepping.getThreadCount()), graph.get(), compactGraph.get(), implicitGraph.get(), queries);
+
+    // NxN table between the starts and ends of the first queries, the pairwise baseline only runs the first row and scales it up
+    if (options.table > 0)
+    {
+        const size_t tableSize = min((size_t)options.table, queries.size());
+        vector<uint32_t> sources, targets;
+        for (size_t i = 0; i < tableSize; i++)
+        {
+            sources.push_back(queries[i].start);
+            targets.push_back(queries[i].end);
+        }
+
+        vector<Query> firstRow;
+        for (const uint32_t target : targets) firstRow.push_back({ sources[0], target });
+        SearchWorkspace workspace;
+        vector<float> firstRowWeights;
+        const auto startTime = high_resolution_clock().now();
+        for (const Query& query : firstRow)
+        {
+            const SearchResult result = implicitGraph ? dijkstra.runSync(*implicitGraph, query.start, query.end, workspace)
+                : compactGraph ? dijkstra.runSync(*compactGraph, *compactGraph->nodeAt(query.start), *compactGraph->nodeAt(query.end), workspace)
+                : dijkstra.runSync(*graph, *graph->nodeAt(query.start), *graph->nodeAt(query.end), workspace);
+            firstRowWeights.push_back(result.pathFound ? result.pathWeight : numeric_limits<float>::infinity());
+        }
+        const duration<double, milli> pairwiseTime = (high_resolution_clock().now() - startTime) * tableSize;
+
+        const ManyToMany manyToMany((size_t)options.threads);
+        const DistanceTable table = implicitGraph ? manyToMany.run(*implicitGraph, sources, targets) : compactGraph ? manyToMany.run(*compactGraph, sources, targets) : manyToMany.run(*graph, sources, targets);
+
+        cout << format("\n{:<22}{:>12}\n", format("{}x{} table", tableSize, tableSize), "time [ms]");
+        cout << format("{:<22}{:>12.1f}\n", "Dijkstra per pair", pairwiseTime.count());
+        cout << format("{:<22}{:>12.1f}\n", format("ManyToMany x{}", manyToMany.getThreadCount()), duration<double, milli>(table.runtime).count());
+
+        vector<float> tableRow;
+        for (size_t target = 0; target < tableSize; target++) tableRow.push_back(table.at(0, target));
+        mismatches += verifyWeights("ManyToMany", tableRow, firstRowWeights);
+        if (options.contract)
+        {
+            const DistanceTable bucketTable = manyToMany.run(*contractionHierarchySearch.getHierarchy(), sources, targets);
+            cout << format("{:<22}{:>12.1f}\n", "ManyToMany CH buckets", duration<double, milli>(bucketTable.runtime).count());
+
+            // the whole bucket table against the plain table, its first row was already checked against Dijkstra
+            mismatches += verifyWeights("ManyToMany CH buckets", bucketTable.distances, table.distances);
+        }
+    }
+
+    // a unit walks along the path of the first query while the cells ahead of it change height, after every step its path is repaired
+    if (options.replan > 0)
+    {
+        const shared_ptr<ImplicitGridGraph> terrain = builder.buildImplicit();
+        DStarLite replanner;
+        replanner.setLayout(terrain);
+        const AStar freshPlanner;
+        SearchWorkspace workspace;
+        uniform_int_distribution<int> heightDistribution(0, HEIGHTMAP_STEPS);
+
+        const Query& query = queries[0];
+        vector<uint32_t> path = replanner.plan(query.start, query.end).indexPath;
+        nanoseconds replanTime = nanoseconds::zero(), freshTime = nanoseconds::zero();
+        size_t replanExplored = 0, freshExplored = 0;
+        int steps = 0;
+
+        for (; steps < options.replan && path.size() > 1; steps++)
+        {
+            const uint32_t position = path[1];
+            const uint32_t cell = path[min(path.size() - 1, (size_t)2 + random() % 8)];
+            terrain->setHeight(terrain->getX(cell), terrain->getY(cell), heightDistribution(random));
+
+            const auto startTime = high_resolution_clock().now();
+            replanner.updateCells({ cell });
+            const SearchResult replanned = replanner.replan(position);
+            replanTime += high_resolution_clock().now() - startTime;
+            replanExplored += replanned.nodesExplored;
+
+            const SearchResult fresh = freshPlanner.runSync(*terrain, position, query.end, workspace);
+            freshTime += fresh.runtime;
+            freshExplored += fresh.nodesExplored;
+
+            path = replanned.indexPath;
+        }
+
+        cout << format("\n{:<14}{:>10}{:>12}{:>16}\n", "replanning", "steps", "time [ms]", "avg expanded");
+        if (steps > 0)
+        {
+            cout << format("{:<14}{:>10}{:>12.2f}{:>16.1f}\n", "AStar", steps, duration<double, milli>(freshTime).count(), (double)freshExplored / steps);
+            cout << format("{:<14}{:>10}{:>12.2f}{:>16.1f}\n", "D* Lite", steps, duration<double, milli>(replanTime).count(), (double)replanExplored / steps);
+        }
+    }
+
+    // removed nodes leave holes in the index range, delta-stepping has to agree with Dijkstra on a fresh graph that has one
+    if (graph && queries[0].start != queries[0].end)
+    {
+        const shared_ptr<Graph> holedGraph = builder.build()->graph;
+        const Node* removed = holedGraph->nodeAt(queries[0].end);
+        for (const unique_ptr<Node>& node : holedGraph->getNodes()) if (node) node->removeEdge(*removed);
+        holedGraph->removeNode(removed->getName());
+
+        const Node& source = *holedGraph->nodeAt(queries[0].start);
+        const DistanceField deltaField = parallelDeltaStepping.run(*holedGraph, source);
+        SearchWorkspace workspace;
+        vector<SettledNode> dijkstraField;
+        dijkstra.runField(*holedGraph, source, workspace, dijkstraField);
+
+        const bool agree = countReached(deltaField) == dijkstraField.size() && all_of(dijkstraField.begin(), dijkstraField.end(), [&deltaField](const SettledNode& settled)
+        {
+            return abs(deltaField.distances[settled.index] - settled.pathWeight) <= 1e-4f * max(1.0f, settled.pathWeight);
+        });
+        cout << format("\n{:<14}{:>10}{:>12}\n", "removed node", "reached", "agrees");
+        cout << format("{:<14}{:>10}{:>12}\n", "DeltaStep", countReached(deltaField), agree ? "yes" : "no");
+        if (!agree) mismatches++;
+    }
+
+    if (mismatches > 0)
+    {
+        cerr << format("\n{} results disagree with Dijkstra\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -1,10 +1,54 @@
 #include "AStar.h"
-#include <queue>
-#include <unordered_set>
 
 using namespace Pathfinding;
 
-Coroutine AStar::search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch)
+template<typename GraphType, typename Heuristic, typename Queue, typename Recorder>
+void AStar::expand(const GraphType& graph, const Heuristic& heuristic, Queue& discovered, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const
+{
+	for (const auto [neighbour, weight] : graph.getEdges(current))
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new neighbours of current node
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight, heuristic(neighbour));
+			discovered.push(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of neighbour is worse than current path -> replace pathData and move neighbour up in the queue, explored nodes are reopened
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace[neighbour].explored = false;
+			discovered.pushOrDecrease(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+	}
+}
+
+template<typename GraphType, typename Run>
+auto AStar::runWithQueue(const GraphType& graph, SearchWorkspace& workspace, const Run& run) const
+{
+	// estimates are rarely integers, so bounded integer weights pick the radix heap which only needs estimates that never decrease
+	switch (queuePolicy != QueuePolicy::Automatic ? queuePolicy : getIntegerWeightBound(graph) ? QueuePolicy::Radix : QueuePolicy::BinaryHeap)
+	{
+		case QueuePolicy::Bucket:
+			throw std::exception("AStar can not use a bucket queue, its estimates are not integers in general.");
+
+		case QueuePolicy::Radix:
+			workspace.estimateRadixHeap.reset(graph.getIndexCount());
+			return run(workspace.estimateRadixHeap);
+
+		default:
+			return run(workspace.estimateHeap);
+	}
+}
+
+template<typename GraphType, typename Heuristic, typename Targets, typename Queue>
+Coroutine AStar::searchIndexed(const GraphType& graph, const Heuristic heuristic, const uint32_t start, const Targets targets, Queue& discovered, SearchWorkspace& workspace, bool& incrementalSearch)
 {
 	using namespace std;
 	using namespace std::chrono;
@@ -18,34 +62,20 @@ Coroutine AStar::search(const Graph& graph, const Node& start, const Node& end,
 		throw exception("AStar was run without assigning a heuristic function first.");
 	}
 
-	const Node* current = nullptr;
-	unordered_map<const Node*, AStarPathData> pathData;
-
-	auto compare = [&](const Node* left, const Node* right)
-	{
-		const auto& leftData = pathData[left];
-		const auto& rightData = pathData[right];
-
-		if (leftData.sortingValue != rightData.sortingValue)
-			return leftData.sortingValue > rightData.sortingValue;
-
-		return leftData.heuristicValue > rightData.heuristicValue;
-	};
-
-	vector<const Node*> vec;
-	vec.reserve(graph.getNodes().size());
-	priority_queue<const Node*, vector<const Node*>, decltype(compare)> discovered(compare, move(vec));
-	unordered_set<const Node*> explored;
+	const SearchRecorder<AStarPathData> record { searchLog };
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
 	size_t previousSearchLogSize;
 
-	discovered.push(&start);
-	pathData.insert({ &start, AStarPathData { nullptr, 0, getHeuristic(graph, start, end) } });
+	workspace.reset(graph.getIndexCount());
+
+	workspace.discover(start, INVALID_INDEX, 0, heuristic(start));
+	discovered.push(start, { workspace[start].heuristicValue, workspace[start].heuristicValue });
 
 	while (!discovered.empty())
 	{
-		current = discovered.top();
-		discovered.pop();
-		searchLog.push_back({ current, NodeState::CURRENT, pathData[current] });
+		current = discovered.pop();
+		record(graph, workspace, current, NodeState::CURRENT);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
@@ -54,57 +84,144 @@ Coroutine AStar::search(const Graph& graph, const Node& start, const Node& end,
 		previousSearchLogSize = searchLog.size();
 
 		// if whole path is found -> break out of loop
-		if (*current == end) break;
+		if (targets.contains(current)) break;
 
-		for (auto& edge : current->getEdges())
-		{
-			const float neighbourPathWeight = pathData[current].pathWeight + edge->weight;
-			const bool neighbourUnknown = !pathData.contains(edge->neighbour);			
-
-			// discover new neighbours of current node
-			if (neighbourUnknown)
-			{
-				const AStarPathData nodeData { current, neighbourPathWeight, getHeuristic(graph, *edge->neighbour, end) };
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				discovered.push(edge->neighbour);
-				searchLog.push_back({ edge->neighbour, NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-
-			// if pathWeight of neighbour is worse than current path -> replace pathData
-			else if (pathData[edge->neighbour].pathWeight > neighbourPathWeight)
-			{
-				const AStarPathData nodeData { current, neighbourPathWeight, pathData[edge->neighbour].heuristicValue };
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				const bool neighbourExplored = explored.contains(edge->neighbour);
-				searchLog.push_back({ edge->neighbour, neighbourExplored ? NodeState::PROCESSED : NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-		}
+		expand(graph, heuristic, discovered, workspace, current, record);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
 		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
 		startTime = high_resolution_clock().now();
 
-		explored.insert(current);
-		searchLog.push_back({ current, NodeState::PROCESSED, pathData[current] });
+		workspace[current].explored = true;
+		exploredCount++;
+		record(graph, workspace, current, NodeState::PROCESSED);
 	}
 
 	runtime += high_resolution_clock().now() - startTime;
 
 	// no path found
-	if (*current != end)
+	if (current == INVALID_INDEX || !targets.contains(current))
 	{
-		searchResult = make_shared<SearchResult>(explored.size(), runtime);
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
 		co_return;
 	}
 
-	list<const Node*> path;
-	while (current != nullptr)
+	searchResult = make_shared<SearchResult>(buildResult(graph, workspace, current, exploredCount + 1, runtime));
+
+}
+
+template<typename GraphType, typename Heuristic, typename Targets, typename Queue>
+SearchResult AStar::runIndexed(const GraphType& graph, const Heuristic& heuristic, const uint32_t start, const Targets& targets, Queue& discovered, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+
+	workspace.reset(graph.getIndexCount());
+
+	workspace.discover(start, INVALID_INDEX, 0, heuristic(start));
+	discovered.push(start, { workspace[start].heuristicValue, workspace[start].heuristicValue });
+
+	while (!discovered.empty())
 	{
-		path.push_front(current);
-		current = pathData[current].previousNode;
+		current = discovered.pop();
+		if (targets.contains(current)) break;
+
+		expand(graph, heuristic, discovered, workspace, current, NullRecorder {});
+		workspace[current].explored = true;
+		exploredCount++;
 	}
 
-	searchResult = make_shared<SearchResult>(true, pathData[&end].pathWeight, move(path), explored.size() + 1, runtime);
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (current == INVALID_INDEX || !targets.contains(current)) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, workspace, current, exploredCount + 1, runtime);
+}
+
+// the estimate of a target set is the smallest estimate of its targets, like a virtual sink behind all targets would have
+template<typename Heuristic>
+static auto toNearestTarget(const Heuristic& heuristic, const TargetSet& targets)
+{
+	return [heuristic, targets = targets.getIndices()](const uint32_t current)
+	{
+		float estimate = std::numeric_limits<float>::infinity();
+		for (const uint32_t target : targets) estimate = std::min(estimate, heuristic(current, target));
+		return targets.empty() ? 0.0f : estimate;
+	};
+}
+
+Coroutine AStar::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	const auto heuristic = [this, &graph, end = end.getIndex()](const uint32_t current) { return getHeuristic(graph, *graph.nodeAt(current), *graph.nodeAt(end)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, heuristic, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace, incrementalSearch); });
+}
+
+Coroutine AStar::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	const auto heuristic = [this, &graph, end = end.getIndex()](const uint32_t current) { return getHeuristic(graph.getSource(), *graph.nodeAt(current), *graph.nodeAt(end)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, heuristic, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace, incrementalSearch); });
+}
+
+SearchResult AStar::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!getHeuristic) throw std::exception("AStar was run without assigning a heuristic function first.");
+
+	const auto heuristic = [this, &graph, end = end.getIndex()](const uint32_t current) { return getHeuristic(graph, *graph.nodeAt(current), *graph.nodeAt(end)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, heuristic, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace); });
+}
 
+SearchResult AStar::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!getHeuristic) throw std::exception("AStar was run without assigning a heuristic function first.");
+
+	const auto heuristic = [this, &graph, end = end.getIndex()](const uint32_t current) { return getHeuristic(graph.getSource(), *graph.nodeAt(current), *graph.nodeAt(end)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, heuristic, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace); });
+}
+
+SearchResult AStar::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	// implicit grids have no nodes to hand to getHeuristic, their own distance estimate is used instead
+	const auto heuristic = [&graph, end](const uint32_t current) { return graph.getDistanceEstimate(current, end); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, heuristic, start, SingleTarget { end }, discovered, workspace); });
+}
+
+Coroutine AStar::search(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	const auto heuristic = [this, &graph](const uint32_t current, const uint32_t target) { return getHeuristic(graph, *graph.nodeAt(current), *graph.nodeAt(target)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, toNearestTarget(heuristic, targets), start.getIndex(), targets, discovered, workspace, incrementalSearch); });
+}
+
+Coroutine AStar::search(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	const auto heuristic = [this, &graph](const uint32_t current, const uint32_t target) { return getHeuristic(graph.getSource(), *graph.nodeAt(current), *graph.nodeAt(target)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, toNearestTarget(heuristic, targets), start.getIndex(), targets, discovered, workspace, incrementalSearch); });
+}
+
+SearchResult AStar::runSync(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	if (!getHeuristic) throw std::exception("AStar was run without assigning a heuristic function first.");
+
+	const auto heuristic = [this, &graph](const uint32_t current, const uint32_t target) { return getHeuristic(graph, *graph.nodeAt(current), *graph.nodeAt(target)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, toNearestTarget(heuristic, targets), start.getIndex(), targets, discovered, workspace); });
+}
+
+SearchResult AStar::runSync(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	if (!getHeuristic) throw std::exception("AStar was run without assigning a heuristic function first.");
+
+	const auto heuristic = [this, &graph](const uint32_t current, const uint32_t target) { return getHeuristic(graph.getSource(), *graph.nodeAt(current), *graph.nodeAt(target)); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, toNearestTarget(heuristic, targets), start.getIndex(), targets, discovered, workspace); });
+}
+
+SearchResult AStar::runSync(const ImplicitGridGraph& graph, const uint32_t start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	const auto heuristic = [&graph](const uint32_t current, const uint32_t target) { return graph.getDistanceEstimate(current, target); };
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, toNearestTarget(heuristic, targets), start, targets, discovered, workspace); });
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include "Pathfinder.h"
+#include "QueuePolicy.h"
+#include "TargetSet.h"
 
 namespace Pathfinding
 {
@@ -13,13 +15,43 @@ namespace Pathfinding
 		{
 			sortingValue = pathWeight + heuristicValue;
 		}
+		AStarPathData(const Node* previousNode, const SearchWorkspace::Slot& slot) : AStarPathData(previousNode, slot.pathWeight, slot.heuristicValue) {}
 	};
 
 	class AStar : public Pathfinder
 	{
+		private:
+
+		template<typename GraphType, typename Heuristic, typename Queue, typename Recorder>
+		void expand(const GraphType& graph, const Heuristic& heuristic, Queue& discovered, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const;
+
+		// resets the queue chosen for the graph and hands it to run
+		template<typename GraphType, typename Run>
+		auto runWithQueue(const GraphType& graph, SearchWorkspace& workspace, const Run& run) const;
+
+		// the heuristic estimates the distance to the targets, it is taken by value together with the targets to live as long as the coroutine frame
+		template<typename GraphType, typename Heuristic, typename Targets, typename Queue>
+		Coroutine searchIndexed(const GraphType& graph, const Heuristic heuristic, const uint32_t start, const Targets targets, Queue& discovered, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType, typename Heuristic, typename Targets, typename Queue>
+		SearchResult runIndexed(const GraphType& graph, const Heuristic& heuristic, const uint32_t start, const Targets& targets, Queue& discovered, SearchWorkspace& workspace) const;
+
 		public:
 
 		std::function<float(const Graph& graph, const Node& current, const Node& target)> getHeuristic;
-		Coroutine search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch) override;
+		QueuePolicy queuePolicy = QueuePolicy::Automatic;
+
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+
+		// path to the cheapest reachable node of the target set, every node is estimated against its nearest target
+		Coroutine search(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch);
+		Coroutine search(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch);
+		SearchResult runSync(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const TargetSet& targets, SearchWorkspace& workspace) const;
 	};
 }
\ No newline at end of file
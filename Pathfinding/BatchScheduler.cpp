@@ -0,0 +1,142 @@
+#include "BatchScheduler.h"
+#include <mutex>
+#include <thread>
+
+using namespace Pathfinding;
+
+static size_t getWorkerCount(const size_t threadCount)
+{
+	return threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+}
+
+BatchScheduler::BatchScheduler(const Graph& graph, const size_t threadCount) : workspaces(getWorkerCount(threadCount))
+{
+	runJob = [&graph](const BatchJob& job, SearchWorkspace& workspace) { return job.pathfinder->runSync(graph, *graph.nodeAt(job.start), *graph.nodeAt(job.end), workspace); };
+}
+
+BatchScheduler::BatchScheduler(const CompactGraph& graph, const size_t threadCount) : workspaces(getWorkerCount(threadCount))
+{
+	runJob = [&graph](const BatchJob& job, SearchWorkspace& workspace) { return job.pathfinder->runSync(graph, *graph.nodeAt(job.start), *graph.nodeAt(job.end), workspace); };
+}
+
+BatchScheduler::BatchScheduler(const ImplicitGridGraph& graph, const size_t threadCount) : workspaces(getWorkerCount(threadCount))
+{
+	runJob = [&graph](const BatchJob& job, SearchWorkspace& workspace) { return job.pathfinder->runSync(graph, job.start, job.end, workspace); };
+}
+
+bool BatchScheduler::take(JobRange& own, uint32_t& job)
+{
+	// the owner works from the front of its block
+	uint64_t range = own.range.load(std::memory_order_relaxed);
+	while (getBegin(range) < getEnd(range))
+	{
+		if (own.range.compare_exchange_weak(range, pack(getBegin(range) + 1, getEnd(range)), std::memory_order_relaxed))
+		{
+			job = getBegin(range);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool BatchScheduler::steal(std::vector<JobRange>& ranges, const size_t thief)
+{
+	// jobs are never added during a batch, so once every block is empty the remaining work is only the jobs already taken
+	while (true)
+	{
+		size_t victim = thief;
+		uint64_t victimRange = 0;
+		for (size_t worker = 0; worker < ranges.size(); worker++)
+		{
+			const uint64_t range = ranges[worker].range.load(std::memory_order_relaxed);
+			if (worker != thief && getEnd(range) - getBegin(range) > getEnd(victimRange) - getBegin(victimRange))
+			{
+				victim = worker;
+				victimRange = range;
+			}
+		}
+		if (victim == thief) return false;
+
+		// the thief takes the back half, a single job left is taken whole
+		const uint32_t begin = getBegin(victimRange), end = getEnd(victimRange);
+		const uint32_t middle = end - (end - begin + 1) / 2;
+		if (ranges[victim].range.compare_exchange_strong(victimRange, pack(begin, middle), std::memory_order_relaxed))
+		{
+			// nobody changes an empty block, so the thief's own block can simply be replaced
+			ranges[thief].range.store(pack(middle, end), std::memory_order_relaxed);
+			return true;
+		}
+	}
+}
+
+BatchResult BatchScheduler::run(const std::vector<BatchJob>& jobs)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	if (jobs.size() >= INVALID_INDEX) throw exception("BatchScheduler can not run that many jobs in one batch.");
+
+	const auto startTime = high_resolution_clock().now();
+	const size_t workerCount = workspaces.size();
+
+	vector<optional<SearchResult>> answers(jobs.size());
+	vector<WorkerStatistics> statistics(workerCount);
+	vector<JobRange> ranges(workerCount);
+	for (size_t worker = 0; worker < workerCount; worker++)
+	{
+		ranges[worker].range.store(pack((uint32_t)(jobs.size() * worker / workerCount), (uint32_t)(jobs.size() * (worker + 1) / workerCount)), memory_order_relaxed);
+	}
+
+	atomic<bool> failed = false;
+	exception_ptr error;
+	mutex errorMutex;
+
+	auto work = [&](const size_t worker)
+	{
+		WorkerStatistics& own = statistics[worker];
+		while (!failed.load(memory_order_relaxed))
+		{
+			uint32_t job;
+			if (!take(ranges[worker], job))
+			{
+				if (!steal(ranges, worker)) break;
+				own.steals++;
+				continue;
+			}
+
+			const auto jobStartTime = high_resolution_clock().now();
+			try
+			{
+				answers[job].emplace(runJob(jobs[job], workspaces[worker]));
+			}
+			catch (...)
+			{
+				lock_guard lock(errorMutex);
+				if (!error) error = current_exception();
+				failed = true;
+			}
+			own.busyTime += high_resolution_clock().now() - jobStartTime;
+			own.jobsRun++;
+		}
+	};
+
+	// the calling thread is worker 0
+	{
+		vector<jthread> workers;
+		for (size_t worker = 1; worker < workerCount; worker++) workers.emplace_back(work, worker);
+		work(0);
+	}
+	if (error) rethrow_exception(error);
+
+	BatchResult result;
+	result.runtime = high_resolution_clock().now() - startTime;
+	result.results.reserve(jobs.size());
+	for (optional<SearchResult>& answer : answers) result.results.push_back(move(*answer));
+
+	for (WorkerStatistics& worker : statistics)
+	{
+		worker.utilisation = result.runtime.count() > 0 ? (double)worker.busyTime.count() / result.runtime.count() : 0;
+	}
+	result.workers = move(statistics);
+	return result;
+}
\ No newline at end of file
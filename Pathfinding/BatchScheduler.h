@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	struct BatchJob
+	{
+		const Pathfinder* pathfinder;
+		uint32_t start;
+		uint32_t end;
+	};
+
+	// busy time only counts time spent inside searches, utilisation is busy time over the runtime of the batch
+	struct WorkerStatistics
+	{
+		size_t jobsRun = 0;
+		size_t steals = 0;
+		std::chrono::nanoseconds busyTime = std::chrono::nanoseconds::zero();
+		double utilisation = 0;
+	};
+
+	struct BatchResult
+	{
+		std::vector<SearchResult> results;
+		std::vector<WorkerStatistics> workers;
+		std::chrono::nanoseconds runtime = std::chrono::nanoseconds::zero();
+	};
+
+	// runs batches of queries against one graph, every worker starts on its own contiguous block of jobs
+	// workers that run out steal half of the remaining block of the busiest worker, so long queries do not leave threads idle
+	class BatchScheduler
+	{
+		private:
+
+		// begin and end of the jobs left to a worker packed into one word, so taking and stealing are single compare and swaps
+		struct alignas(64) JobRange
+		{
+			std::atomic<uint64_t> range;
+		};
+
+		std::function<SearchResult(const BatchJob& job, SearchWorkspace& workspace)> runJob;
+		std::vector<SearchWorkspace> workspaces;
+
+		static uint64_t pack(const uint32_t begin, const uint32_t end) { return ((uint64_t)begin << 32) | end; }
+		static uint32_t getBegin(const uint64_t range) { return (uint32_t)(range >> 32); }
+		static uint32_t getEnd(const uint64_t range) { return (uint32_t)range; }
+
+		static bool take(JobRange& own, uint32_t& job);
+		static bool steal(std::vector<JobRange>& ranges, const size_t thief);
+
+		public:
+
+		// no thread count uses every hardware thread
+		BatchScheduler(const Graph& graph, const size_t threadCount = 0);
+		BatchScheduler(const CompactGraph& graph, const size_t threadCount = 0);
+		BatchScheduler(const ImplicitGridGraph& graph, const size_t threadCount = 0);
+
+		size_t getThreadCount() const { return workspaces.size(); }
+
+		// results are in the order of the jobs, the workspaces are reused by the next batch so only one batch may run at a time
+		// pathfinders are only used through runSync, the first exception of a search stops the batch and is rethrown
+		BatchResult run(const std::vector<BatchJob>& jobs);
+	};
+}
\ No newline at end of file
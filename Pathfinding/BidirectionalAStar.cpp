@@ -0,0 +1,15 @@
+#include "BidirectionalAStar.h"
+
+using namespace Pathfinding;
+
+float BidirectionalAStar::estimate(const Graph& graph, const Node& from, const Node& to) const
+{
+	if (!getHeuristic) throw std::exception("BidirectionalAStar was run without assigning a heuristic function first.");
+	return getHeuristic(graph, from, to);
+}
+
+float BidirectionalAStar::estimate(const ImplicitGridGraph& graph, const uint32_t from, const uint32_t to) const
+{
+	// implicit grids have no nodes to hand to getHeuristic, their own distance estimate is used instead
+	return graph.getDistanceEstimate(from, to);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include "BidirectionalSearch.h"
+
+namespace Pathfinding
+{
+	class BidirectionalAStar : public BidirectionalSearch
+	{
+		protected:
+
+		float estimate(const Graph& graph, const Node& from, const Node& to) const override;
+		float estimate(const ImplicitGridGraph& graph, const uint32_t from, const uint32_t to) const override;
+
+		public:
+
+		std::function<float(const Graph& graph, const Node& current, const Node& target)> getHeuristic;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+#include "BidirectionalSearch.h"
+
+namespace Pathfinding
+{
+	class BidirectionalDijkstra : public BidirectionalSearch
+	{
+		protected:
+
+		float estimate(const Graph&, const Node&, const Node&) const override { return 0; }
+		float estimate(const ImplicitGridGraph&, const uint32_t, const uint32_t) const override { return 0; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "BidirectionalSearch.h"
+
+using namespace Pathfinding;
+
+template<typename GraphType, typename Potential, typename Recorder>
+void BidirectionalSearch::expand(const GraphType& graph, const Potential& potential, SearchWorkspace& workspace, const SearchWorkspace& opposite, const uint32_t current, Meeting& meeting, const Recorder& record) const
+{
+	for (const auto [neighbour, weight] : graph.getEdges(current))
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new neighbours of current node
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight, potential(neighbour));
+			workspace.pathWeightHeap.push(neighbour, neighbourPathWeight + workspace[neighbour].heuristicValue);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of neighbour is worse than current path -> replace pathData and move neighbour up in the queue, explored nodes are reopened
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace[neighbour].explored = false;
+			workspace.pathWeightHeap.pushOrDecrease(neighbour, neighbourPathWeight + workspace[neighbour].heuristicValue);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		else continue;
+
+		// if the other search already reached the neighbour -> both halves form a path, keep the best one
+		if (opposite.isKnown(neighbour) && neighbourPathWeight + opposite[neighbour].pathWeight < meeting.pathWeight)
+		{
+			meeting = { neighbourPathWeight + opposite[neighbour].pathWeight, neighbour };
+		}
+	}
+}
+
+template<typename GraphType>
+SearchResult BidirectionalSearch::buildResult(const GraphType& graph, const SearchWorkspace& workspace, const SearchWorkspace& backward, const Meeting& meeting, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+{
+	// walk back to the start node, then follow the backward search to the end node
+	std::vector<uint32_t> indexPath;
+	for (uint32_t current = meeting.index; current != INVALID_INDEX; current = workspace[current].previous)
+	{
+		indexPath.push_back(current);
+	}
+	std::reverse(indexPath.begin(), indexPath.end());
+
+	for (uint32_t current = backward[meeting.index].previous; current != INVALID_INDEX; current = backward[current].previous)
+	{
+		indexPath.push_back(current);
+	}
+
+	std::list<const Node*> path;
+	if constexpr (requires { graph.nodeAt(meeting.index); })
+	{
+		for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+	}
+
+	return SearchResult(true, meeting.pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+}
+
+template<typename GraphType, typename Potential>
+Coroutine BidirectionalSearch::searchIndexed(const GraphType& graph, const std::shared_ptr<const CompactGraph> reverse, const Potential potential, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	nanoseconds runtime = nanoseconds::zero();
+	auto startTime = high_resolution_clock().now();
+
+	const SearchRecorder<PathData> record { searchLog };
+	const auto reversePotential = [&potential](const uint32_t index) { return -potential(index); };
+	Meeting meeting;
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+	size_t previousSearchLogSize;
+
+	SearchWorkspace& backward = workspace.getBackward();
+	workspace.reset(graph.getIndexCount());
+	backward.reset(graph.getIndexCount());
+	auto& forwardDiscovered = workspace.pathWeightHeap;
+	auto& backwardDiscovered = backward.pathWeightHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0, potential(start));
+	forwardDiscovered.push(start, workspace[start].heuristicValue);
+	backward.discover(end, INVALID_INDEX, 0, reversePotential(end));
+	backwardDiscovered.push(end, backward[end].heuristicValue);
+	if (start == end) meeting = { 0, start };
+
+	while (!forwardDiscovered.empty() && !backwardDiscovered.empty())
+	{
+		// if no connection through the frontiers can be shorter than the best meeting -> path is found
+		if (forwardDiscovered.topKey() + backwardDiscovered.topKey() >= meeting.pathWeight) break;
+
+		// grow the search with the smaller frontier key
+		const bool forwardStep = forwardDiscovered.topKey() <= backwardDiscovered.topKey();
+		SearchWorkspace& stepWorkspace = forwardStep ? workspace : backward;
+		current = forwardStep ? forwardDiscovered.pop() : backwardDiscovered.pop();
+		if (forwardStep) record(graph, workspace, current, NodeState::CURRENT);
+		else record(*reverse, backward, current, NodeState::CURRENT);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if(&incrementalSearch);
+		startTime = high_resolution_clock().now();
+		previousSearchLogSize = searchLog.size();
+
+		if (forwardStep) expand(graph, potential, workspace, backward, current, meeting, record);
+		else expand(*reverse, reversePotential, backward, workspace, current, meeting, record);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
+		startTime = high_resolution_clock().now();
+
+		stepWorkspace[current].explored = true;
+		exploredCount++;
+		if (forwardStep) record(graph, workspace, current, NodeState::PROCESSED);
+		else record(*reverse, backward, current, NodeState::PROCESSED);
+	}
+
+	runtime += high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (meeting.index == INVALID_INDEX)
+	{
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
+		co_return;
+	}
+
+	searchResult = make_shared<SearchResult>(buildResult(graph, workspace, backward, meeting, exploredCount, runtime));
+}
+
+template<typename GraphType, typename ReverseType, typename Potential>
+SearchResult BidirectionalSearch::runIndexed(const GraphType& graph, const ReverseType& reverse, const Potential& potential, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	const auto reversePotential = [&potential](const uint32_t index) { return -potential(index); };
+	Meeting meeting;
+	size_t exploredCount = 0;
+
+	SearchWorkspace& backward = workspace.getBackward();
+	workspace.reset(graph.getIndexCount());
+	backward.reset(graph.getIndexCount());
+	auto& forwardDiscovered = workspace.pathWeightHeap;
+	auto& backwardDiscovered = backward.pathWeightHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0, potential(start));
+	forwardDiscovered.push(start, workspace[start].heuristicValue);
+	backward.discover(end, INVALID_INDEX, 0, reversePotential(end));
+	backwardDiscovered.push(end, backward[end].heuristicValue);
+	if (start == end) meeting = { 0, start };
+
+	while (!forwardDiscovered.empty() && !backwardDiscovered.empty())
+	{
+		if (forwardDiscovered.topKey() + backwardDiscovered.topKey() >= meeting.pathWeight) break;
+
+		if (forwardDiscovered.topKey() <= backwardDiscovered.topKey())
+		{
+			const uint32_t current = forwardDiscovered.pop();
+			expand(graph, potential, workspace, backward, current, meeting, NullRecorder {});
+			workspace[current].explored = true;
+		}
+		else
+		{
+			const uint32_t current = backwardDiscovered.pop();
+			expand(reverse, reversePotential, backward, workspace, current, meeting, NullRecorder {});
+			backward[current].explored = true;
+		}
+		exploredCount++;
+	}
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (meeting.index == INVALID_INDEX) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, workspace, backward, meeting, exploredCount, runtime);
+}
+
+std::shared_ptr<const CompactGraph> BidirectionalSearch::getReverseGraph(const Graph& graph) const
+{
+	// only read here, so concurrent runSync calls never wait for each other
+	const std::shared_ptr<const CompactGraph> reverse = reverseGraph;
+
+	// changed weights are applied to a copy, other searches keep the prepared graph, it is rebuilt if the change log dropped some of them
+	if (reverse && &reverse->getSource() == &graph && reverse->getIndexCount() == graph.getIndexCount())
+	{
+		if (reverse->getVersion() == graph.getVersion()) return reverse;
+
+		const std::shared_ptr<CompactGraph> updated = std::make_shared<CompactGraph>(*reverse);
+		if (updated->applyChanges()) return updated;
+	}
+
+	// another graph is searched or nodes were added
+	return std::make_shared<CompactGraph>(graph, EdgeDirection::Incoming);
+}
+
+std::shared_ptr<const CompactGraph> BidirectionalSearch::getReverseGraph(const CompactGraph& graph) const
+{
+	if (graph.getReverse()) return graph.getReverse();
+
+	// the reverse of the source only fits graphs with the weights of the source, other versions are reversed themselves
+	if (graph.getDirection() == EdgeDirection::Outgoing && graph.getSnapshotVersion() == 0 && graph.getVersion() == graph.getSource().getVersion()) return getReverseGraph(graph.getSource());
+	return graph.createReverse();
+}
+
+void BidirectionalSearch::prepareReverseGraph(const Graph& graph)
+{
+	reverseGraph = getReverseGraph(graph);
+}
+
+void BidirectionalSearch::resetReverseGraph()
+{
+	reverseGraph.reset();
+}
+
+Coroutine BidirectionalSearch::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	// averaged potential, the reverse search uses its negation so both see the same reduced edge weights
+	const auto potential = [this, &graph, &start, &end](const uint32_t index) { return (estimate(graph, *graph.nodeAt(index), end) - estimate(graph, start, *graph.nodeAt(index))) / 2; };
+	prepareReverseGraph(graph);
+	return searchIndexed(graph, reverseGraph, potential, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+Coroutine BidirectionalSearch::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	const Graph& source = graph.getSource();
+	const auto potential = [this, &source, &start, &end](const uint32_t index) { return (estimate(source, *source.nodeAt(index), end) - estimate(source, start, *source.nodeAt(index))) / 2; };
+	return searchIndexed(graph, getReverseGraph(graph), potential, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+SearchResult BidirectionalSearch::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	const auto potential = [this, &graph, &start, &end](const uint32_t index) { return (estimate(graph, *graph.nodeAt(index), end) - estimate(graph, start, *graph.nodeAt(index))) / 2; };
+	return runIndexed(graph, *getReverseGraph(graph), potential, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult BidirectionalSearch::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	const Graph& source = graph.getSource();
+	const auto potential = [this, &source, &start, &end](const uint32_t index) { return (estimate(source, *source.nodeAt(index), end) - estimate(source, start, *source.nodeAt(index))) / 2; };
+	return runIndexed(graph, *getReverseGraph(graph), potential, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult BidirectionalSearch::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	const auto potential = [this, &graph, start, end](const uint32_t index) { return (estimate(graph, index, end) - estimate(graph, start, index)) / 2; };
+	return runIndexed(graph, ImplicitIncomingEdges { graph }, potential, start, end, workspace);
+}
\ No newline at end of file
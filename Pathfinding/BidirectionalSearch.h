@@ -0,0 +1,59 @@
+#pragma once
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	// grows one search from the start and one from the end over the reversed edges until no connection can beat the best meeting node
+	// subclasses only provide the distance estimate, both searches are guided by the averaged potential of it
+	class BidirectionalSearch : public Pathfinder
+	{
+		private:
+
+		struct Meeting
+		{
+			float pathWeight = std::numeric_limits<float>::infinity();
+			uint32_t index = INVALID_INDEX;
+		};
+
+		std::shared_ptr<const CompactGraph> reverseGraph;
+
+		// the prepared reverse graph if it matches the graph, otherwise one of its own for the calling search
+		std::shared_ptr<const CompactGraph> getReverseGraph(const Graph& graph) const;
+
+		// the reverse a compact graph carries, the prepared one if its weights are those of the source, otherwise one of its own
+		std::shared_ptr<const CompactGraph> getReverseGraph(const CompactGraph& graph) const;
+
+		template<typename GraphType, typename Potential, typename Recorder>
+		void expand(const GraphType& graph, const Potential& potential, SearchWorkspace& workspace, const SearchWorkspace& opposite, const uint32_t current, Meeting& meeting, const Recorder& record) const;
+
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, const SearchWorkspace& workspace, const SearchWorkspace& backward, const Meeting& meeting, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const;
+
+		// the reverse graph and the potential are taken by value, they have to live as long as the coroutine frame
+		template<typename GraphType, typename Potential>
+		Coroutine searchIndexed(const GraphType& graph, const std::shared_ptr<const CompactGraph> reverse, const Potential potential, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType, typename ReverseType, typename Potential>
+		SearchResult runIndexed(const GraphType& graph, const ReverseType& reverse, const Potential& potential, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const;
+
+		protected:
+
+		// estimated path weight between two nodes, it has to be consistent and must not overestimate
+		virtual float estimate(const Graph& graph, const Node& from, const Node& to) const = 0;
+		virtual float estimate(const ImplicitGridGraph& graph, const uint32_t from, const uint32_t to) const = 0;
+
+		public:
+
+		// builds the reverse graph once, so runSync only reads it and concurrent searches never build or wait for one
+		// without a matching reverse graph every runSync builds its own, weight changes made through Graph::updateEdges are applied to a copy
+		// coroutine searches prepare it themselves, it has to be reset after edges were added or edited on a Node, must not run while searches are in flight
+		void prepareReverseGraph(const Graph& graph);
+		void resetReverseGraph();
+
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+	};
+}
\ No newline at end of file
@@ -5,8 +5,23 @@ namespace Pathfinding
 {
 	class BreadthFirst : public Pathfinder
 	{
+		private:
+
+		template<typename GraphType, typename Recorder>
+		void expand(const GraphType& graph, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const;
+
+		template<typename GraphType>
+		Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType>
+		SearchResult runIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const;
+
 		public:
 
-		Coroutine search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch) override;
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
 	};
 }
\ No newline at end of file
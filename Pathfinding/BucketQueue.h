@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Pathfinding
+{
+	// Dial's bucket queue over node indices, keys have to be integers that never fall below the last popped key
+	// and never exceed it by more than the largest edge weight, so one cyclic bucket per possible key is enough
+	class BucketQueue
+	{
+		private:
+
+		struct Position
+		{
+			float key;
+			uint32_t slot;
+		};
+
+		mutable std::vector<std::vector<uint32_t>> buckets;
+		std::vector<Position> positions;
+		mutable uint64_t cursor = 0;
+		size_t count = 0;
+
+		std::vector<uint32_t>& getBucket(const float key) const { return buckets[(uint64_t)key % buckets.size()]; }
+
+		// moves the cursor to the bucket of the smallest key
+		void advance() const
+		{
+			while (buckets[cursor % buckets.size()].empty()) cursor++;
+		}
+
+		void remove(const uint32_t index)
+		{
+			std::vector<uint32_t>& bucket = getBucket(positions[index].key);
+			const uint32_t slot = positions[index].slot;
+			bucket[slot] = bucket.back();
+			positions[bucket[slot]].slot = slot;
+			bucket.pop_back();
+			count--;
+		}
+
+		public:
+
+		// positions are not cleared, an index only counts as contained if its bucket slot points back at it
+		void reset(const size_t indexCount, const uint32_t maxKeyStep)
+		{
+			for (std::vector<uint32_t>& bucket : buckets) bucket.clear();
+			buckets.resize((size_t)maxKeyStep + 1);
+			if (positions.size() < indexCount) positions.resize(indexCount);
+			cursor = 0;
+			count = 0;
+		}
+
+		bool empty() const { return count == 0; }
+		size_t size() const { return count; }
+
+		const float& topKey() const
+		{
+			advance();
+			return positions[buckets[cursor % buckets.size()].back()].key;
+		}
+
+		bool contains(const uint32_t index) const
+		{
+			if (buckets.empty()) return false;
+			const std::vector<uint32_t>& bucket = getBucket(positions[index].key);
+			return positions[index].slot < bucket.size() && bucket[positions[index].slot] == index;
+		}
+
+		void push(const uint32_t index, const float key)
+		{
+			std::vector<uint32_t>& bucket = getBucket(key);
+			positions[index] = { key, (uint32_t)bucket.size() };
+			bucket.push_back(index);
+			count++;
+		}
+
+		void decrease(const uint32_t index, const float key)
+		{
+			remove(index);
+			push(index, key);
+		}
+
+		void pushOrDecrease(const uint32_t index, const float key)
+		{
+			if (contains(index)) decrease(index, key);
+			else push(index, key);
+		}
+
+		uint32_t pop()
+		{
+			advance();
+			std::vector<uint32_t>& bucket = buckets[cursor % buckets.size()];
+			const uint32_t index = bucket.back();
+			bucket.pop_back();
+			count--;
+			return index;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "CompactGraph.h"
+#include <cmath>
+#include <unordered_map>
+
+using namespace Pathfinding;
+
+CompactGraph::CompactGraph(const Graph& graph, const EdgeDirection direction) : source(&graph), direction(direction), version(graph.getVersion())
+{
+	const std::shared_ptr<Rows> rows = std::make_shared<Rows>();
+	std::vector<uint32_t>& offsets = rows->offsets;
+	std::vector<uint32_t>& neighbours = rows->neighbours;
+	std::vector<const Node*>& nodes = rows->nodes;
+	std::vector<float> weights;
+	this->rows = rows;
+
+	const size_t nodeCount = graph.getIndexCount();
+	nodes.reserve(nodeCount);
+
+	// queues of searches can rely on bounded integer weights, so they are checked once while the graph is frozen
+	size_t edgeCount = 0;
+	for (uint32_t index = 0; index < nodeCount; index++)
+	{
+		const Node* node = graph.nodeAt(index);
+		nodes.push_back(node);
+		if (!node) continue;
+
+		edgeCount += node->getEdges().size();
+		for (auto& edge : node->getEdges())
+		{
+			maxWeight = std::max(maxWeight, edge.weight);
+			if (edge.weight < 0 || edge.weight != std::floor(edge.weight)) integerWeights = false;
+		}
+	}
+
+	if (direction == EdgeDirection::Outgoing)
+	{
+		offsets.reserve(nodeCount + 1);
+		neighbours.reserve(edgeCount);
+		weights.reserve(edgeCount);
+
+		// copy edges into contiguous rows, removed nodes keep an empty row
+		for (const Node* node : nodes)
+		{
+			offsets.push_back((uint32_t)neighbours.size());
+			if (!node) continue;
+
+			for (auto& edge : node->getEdges())
+			{
+				neighbours.push_back(edge.neighbour->getIndex());
+				weights.push_back(edge.weight);
+			}
+		}
+		offsets.push_back((uint32_t)neighbours.size());
+	}
+	else
+	{
+		// count incoming edges per node, then turn the counts into row offsets
+		offsets.assign(nodeCount + 1, 0);
+		for (const Node* node : nodes)
+		{
+			if (!node) continue;
+			for (auto& edge : node->getEdges()) offsets[(size_t)edge.neighbour->getIndex() + 1]++;
+		}
+		for (size_t index = 0; index < nodeCount; index++) offsets[index + 1] += offsets[index];
+
+		// scatter every edge into the row of its target
+		neighbours.resize(edgeCount);
+		weights.resize(edgeCount);
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (const Node* node : nodes)
+		{
+			if (!node) continue;
+
+			for (auto& edge : node->getEdges())
+			{
+				const uint32_t position = fill[edge.neighbour->getIndex()]++;
+				neighbours[position] = node->getIndex();
+				weights[position] = edge.weight;
+			}
+		}
+	}
+
+	splitWeights(weights);
+}
+
+void CompactGraph::splitWeights(const std::vector<float>& weights)
+{
+	// the weights of every block of rows are stored on their own, so versions can share them
+	const std::vector<uint32_t>& offsets = rows->offsets;
+	const size_t nodeCount = getIndexCount();
+	weightBlocks.clear();
+	for (size_t firstRow = 0; firstRow < nodeCount; firstRow += (size_t)1 << BLOCK_SHIFT)
+	{
+		const uint32_t firstEdge = offsets[firstRow];
+		const uint32_t lastEdge = offsets[std::min(firstRow + ((size_t)1 << BLOCK_SHIFT), nodeCount)];
+		weightBlocks.push_back(std::make_shared<WeightBlock>(WeightBlock { firstEdge, std::vector<float>(weights.begin() + firstEdge, weights.begin() + lastEdge) }));
+	}
+}
+
+template<typename Change>
+size_t CompactGraph::writeWeights(const std::vector<Change>& changes)
+{
+	const std::vector<uint32_t>& offsets = rows->offsets;
+	const std::vector<uint32_t>& neighbours = rows->neighbours;
+	std::unordered_map<size_t, std::shared_ptr<WeightBlock>> copies;
+	size_t changedCount = 0;
+
+	for (const Change& change : changes)
+	{
+		// incoming rows list the tail of an edge in the row of its head
+		const uint32_t row = direction == EdgeDirection::Outgoing ? change.from : change.to;
+		const uint32_t neighbour = direction == EdgeDirection::Outgoing ? change.to : change.from;
+		if (row >= getIndexCount()) continue;
+
+		const size_t block = row >> BLOCK_SHIFT;
+		std::shared_ptr<WeightBlock>& copy = copies[block];
+		for (uint32_t position = offsets[row]; position < offsets[(size_t)row + 1]; position++)
+		{
+			const WeightBlock& current = copy ? *copy : *weightBlocks[block];
+			if (neighbours[position] != neighbour || current.weights[position - current.firstEdge] == change.weight) continue;
+
+			if (!copy) copy = std::make_shared<WeightBlock>(current);
+			copy->weights[position - copy->firstEdge] = change.weight;
+			changedCount++;
+
+			// both only bound the weights for the queues of searches, so they are never tightened again
+			maxWeight = std::max(maxWeight, change.weight);
+			if (change.weight < 0 || change.weight != std::floor(change.weight)) integerWeights = false;
+		}
+	}
+
+	for (auto& [block, copy] : copies)
+	{
+		if (copy) weightBlocks[block] = std::move(copy);
+	}
+	return changedCount;
+}
+
+bool CompactGraph::applyChanges()
+{
+	// the weights of created versions differ from every version of the source, its changes can not be replayed on them
+	if (snapshotVersion > 0) return false;
+
+	std::vector<EdgeChange> changes;
+	if (!source->getChangesSince(version, changes)) return false;
+
+	// the reverse may still be searched by others, so the changes go to a copy of it
+	if (reverse)
+	{
+		const std::shared_ptr<CompactGraph> updated = std::make_shared<CompactGraph>(*reverse);
+		if (!updated->applyChanges()) return false;
+		reverse = updated;
+	}
+
+	writeWeights(changes);
+	version = source->getVersion();
+	return true;
+}
+
+std::shared_ptr<const CompactGraph> CompactGraph::createReverse() const
+{
+	// the rows are transposed with the weights of this version, so the reverse matches it even if the source moved on
+	const std::shared_ptr<CompactGraph> reversed = std::make_shared<CompactGraph>(*this);
+	reversed->direction = direction == EdgeDirection::Outgoing ? EdgeDirection::Incoming : EdgeDirection::Outgoing;
+	reversed->reverse.reset();
+
+	const size_t nodeCount = getIndexCount();
+	const std::shared_ptr<Rows> rows = std::make_shared<Rows>();
+	rows->nodes = this->rows->nodes;
+	rows->offsets.assign(nodeCount + 1, 0);
+	for (uint32_t index = 0; index < nodeCount; index++)
+	{
+		for (const auto [neighbour, weight] : getEdges(index)) rows->offsets[(size_t)neighbour + 1]++;
+	}
+	for (size_t index = 0; index < nodeCount; index++) rows->offsets[index + 1] += rows->offsets[index];
+
+	rows->neighbours.resize(getEdgeCount());
+	std::vector<float> weights(getEdgeCount());
+	std::vector<uint32_t> fill(rows->offsets.begin(), rows->offsets.end() - 1);
+	for (uint32_t index = 0; index < nodeCount; index++)
+	{
+		for (const auto [neighbour, weight] : getEdges(index))
+		{
+			const uint32_t position = fill[neighbour]++;
+			rows->neighbours[position] = index;
+			weights[position] = weight;
+		}
+	}
+
+	reversed->rows = rows;
+	reversed->splitWeights(weights);
+	return reversed;
+}
+
+std::shared_ptr<const CompactGraph> CompactGraph::createVersion(const std::vector<EdgeUpdate>& updates) const
+{
+	// copying only copies the table of blocks, the blocks themselves are shared until they are written
+	const std::shared_ptr<CompactGraph> next = std::make_shared<CompactGraph>(*this);
+	if (next->writeWeights(updates) == 0) return nullptr;
+
+	// the reverse holds the same edges, so it changes with every version that changed
+	if (reverse) next->reverse = reverse->createVersion(updates);
+
+	next->snapshotVersion = snapshotVersion + 1;
+	return next;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+#include <memory>
+#include "Graph.h"
+
+namespace Pathfinding
+{
+	enum class EdgeDirection
+	{
+		Outgoing,
+		Incoming
+	};
+
+	// frozen compressed sparse row (CSR) copy of a Graph, node ids are the graph's indices and edges of a node are stored contiguously
+	// weights are kept in blocks of rows that are never written once they are shared, so versions of a graph can be searched while newer ones are built
+	class CompactGraph
+	{
+		private:
+
+		// rows only change when the graph is rebuilt, so all versions of a graph share them
+		struct Rows
+		{
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> neighbours;
+			std::vector<const Node*> nodes;
+		};
+
+		// weights of the edges of consecutive rows, a new version only copies the blocks its changes touch
+		struct WeightBlock
+		{
+			uint32_t firstEdge;
+			std::vector<float> weights;
+		};
+
+		static constexpr uint32_t BLOCK_SHIFT = 8;
+
+		const Graph* source;
+		EdgeDirection direction;
+		std::shared_ptr<const Rows> rows;
+		std::vector<std::shared_ptr<const WeightBlock>> weightBlocks;
+		float maxWeight = 0;
+		bool integerWeights = true;
+		uint64_t version;
+		uint64_t snapshotVersion = 0;
+		std::shared_ptr<const CompactGraph> reverse;
+
+		// splits the weights of all rows into blocks
+		void splitWeights(const std::vector<float>& weights);
+
+		// copies every touched block once, so blocks shared with other versions are never written, returns the number of changed weights
+		template<typename Change>
+		size_t writeWeights(const std::vector<Change>& changes);
+
+		public:
+
+		class EdgeRange
+		{
+			private:
+
+			const uint32_t* neighbours;
+			const float* weights;
+			const size_t count;
+
+			public:
+
+			struct Iterator
+			{
+				const uint32_t* neighbour;
+				const float* weight;
+
+				IndexedEdge operator*() const { return { *neighbour, *weight }; }
+				Iterator& operator++() { neighbour++; weight++; return *this; }
+				bool operator!=(const Iterator& other) const { return neighbour != other.neighbour; }
+			};
+
+			EdgeRange(const uint32_t* neighbours, const float* weights, const size_t count) : neighbours(neighbours), weights(weights), count(count) {}
+
+			Iterator begin() const { return { neighbours, weights }; }
+			Iterator end() const { return { neighbours + count, weights + count }; }
+			size_t size() const { return count; }
+		};
+
+		// incoming graphs store the reversed edges, so the row of a node lists every node with an edge into it
+		CompactGraph(const Graph& graph, const EdgeDirection direction = EdgeDirection::Outgoing);
+
+		const Graph& getSource() const { return *source; }
+		EdgeDirection getDirection() const { return direction; }
+		size_t getIndexCount() const { return rows->nodes.size(); }
+		size_t getEdgeCount() const { return rows->neighbours.size(); }
+		float getMaxWeight() const { return maxWeight; }
+		bool hasIntegerWeights() const { return integerWeights; }
+
+		// version of the source graph the weights match, versions created by createVersion keep the one they started from
+		uint64_t getVersion() const { return version; }
+
+		// counts the versions created by createVersion, 0 for graphs built from their source, it is unrelated to the source graph's version
+		uint64_t getSnapshotVersion() const { return snapshotVersion; }
+
+		// catches up with the weight changes of the source graph, returns false if they were dropped from its change log
+		// versions created by createVersion no longer follow their source and always return false, like nodes and edges
+		// added or removed afterwards, they have to be rebuilt from the graph
+		bool applyChanges();
+
+		// next version with the given weights, it shares the rows and every untouched weight block with this graph
+		// the source graph is left as it is, updates of missing edges are skipped and null is returned if no weight changed
+		std::shared_ptr<const CompactGraph> createVersion(const std::vector<EdgeUpdate>& updates) const;
+
+		// the same edges in the opposite direction with the weights of this version, for searches that also walk edges backwards
+		std::shared_ptr<const CompactGraph> createReverse() const;
+
+		// a built reverse is carried along by createVersion and applyChanges, so every version has a reverse with matching weights
+		void buildReverse() { reverse = createReverse(); }
+		const std::shared_ptr<const CompactGraph>& getReverse() const { return reverse; }
+
+		const Node* nodeAt(const uint32_t index) const { return rows->nodes[index]; }
+		EdgeRange getEdges(const uint32_t index) const
+		{
+			const uint32_t first = rows->offsets[index];
+			const WeightBlock& block = *weightBlocks[index >> BLOCK_SHIFT];
+			return EdgeRange(rows->neighbours.data() + first, block.weights.data() + (first - block.firstEdge), rows->offsets[(size_t)index + 1] - first);
+		}
+	};
+}
\ No newline at end of file
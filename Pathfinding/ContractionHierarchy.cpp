@@ -0,0 +1,210 @@
+#include "ContractionHierarchy.h"
+#include <algorithm>
+#include "SearchWorkspace.h"
+
+using namespace Pathfinding;
+
+// keeps only the cheapest edge to every neighbour
+static void improveEdge(std::vector<ContractionHierarchy::HierarchyEdge>& edges, const uint32_t neighbour, const float weight, const uint32_t middle)
+{
+	auto iter = std::find_if(edges.begin(), edges.end(), [&](auto& edge) { return edge.neighbour == neighbour; });
+	if (iter == edges.end()) edges.push_back({ neighbour, weight, middle });
+	else if (weight < iter->weight) *iter = { neighbour, weight, middle };
+}
+
+ContractionHierarchy::ContractionHierarchy(const Graph& graph, const size_t witnessLimit)
+{
+	build(graph, witnessLimit);
+}
+
+ContractionHierarchy::ContractionHierarchy(const ImplicitGridGraph& graph, const size_t witnessLimit)
+{
+	build(graph, witnessLimit);
+}
+
+template<typename GraphType>
+void ContractionHierarchy::build(const GraphType& graph, const size_t witnessLimit)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+	const uint32_t indexCount = (uint32_t)graph.getIndexCount();
+
+	// remaining graph, contracted nodes are removed from the lists of their neighbours and keep their own lists as hierarchy edges
+	vector<vector<HierarchyEdge>> outgoing(indexCount), incoming(indexCount);
+	for (uint32_t index = 0; index < indexCount; index++)
+	{
+		if constexpr (requires { graph.nodeAt(index); })
+		{
+			if (!graph.nodeAt(index)) continue;
+		}
+
+		for (const auto [neighbour, weight] : graph.getEdges(index))
+		{
+			if (neighbour == index) continue;
+			improveEdge(outgoing[index], neighbour, weight, INVALID_INDEX);
+			improveEdge(incoming[neighbour], index, weight, INVALID_INDEX);
+		}
+	}
+
+	SearchWorkspace workspace;
+	vector<pair<uint32_t, HierarchyEdge>> shortcuts;
+	vector<uint32_t> contractedNeighbours(indexCount, 0);
+
+	// every pair of incoming and outgoing edge needs a shortcut unless a witness path avoiding the node is at most as heavy
+	auto findShortcuts = [&](const uint32_t node)
+	{
+		shortcuts.clear();
+
+		float maxOutgoingWeight = 0;
+		for (const HierarchyEdge& edge : outgoing[node]) maxOutgoingWeight = max(maxOutgoingWeight, edge.weight);
+
+		for (const HierarchyEdge& in : incoming[node])
+		{
+			const uint32_t source = in.neighbour;
+			const float limit = in.weight + maxOutgoingWeight;
+			size_t settledCount = 0;
+			size_t targetCount = outgoing[node].size();
+
+			workspace.reset(indexCount);
+			auto& discovered = workspace.pathWeightHeap;
+			workspace.discover(source, INVALID_INDEX, 0);
+			discovered.push(source, 0);
+
+			// the search ends early once every outgoing neighbour of the node is settled
+			while (!discovered.empty() && discovered.topKey() <= limit && settledCount < witnessLimit && targetCount > 0)
+			{
+				const uint32_t current = discovered.pop();
+				workspace[current].explored = true;
+				settledCount++;
+				if (any_of(outgoing[node].begin(), outgoing[node].end(), [current](const HierarchyEdge& edge) { return edge.neighbour == current; })) targetCount--;
+
+				for (const HierarchyEdge& edge : outgoing[current])
+				{
+					if (edge.neighbour == node) continue;
+
+					const float neighbourPathWeight = workspace[current].pathWeight + edge.weight;
+					if (!workspace.isKnown(edge.neighbour))
+					{
+						workspace.discover(edge.neighbour, current, neighbourPathWeight);
+						discovered.push(edge.neighbour, neighbourPathWeight);
+					}
+					else if (!workspace[edge.neighbour].explored && workspace[edge.neighbour].pathWeight > neighbourPathWeight)
+					{
+						workspace[edge.neighbour].pathWeight = neighbourPathWeight;
+						discovered.decrease(edge.neighbour, neighbourPathWeight);
+					}
+				}
+			}
+
+			for (const HierarchyEdge& out : outgoing[node])
+			{
+				if (out.neighbour == source) continue;
+
+				const float shortcutWeight = in.weight + out.weight;
+				if (workspace.isKnown(out.neighbour) && workspace[out.neighbour].pathWeight <= shortcutWeight) continue;
+				shortcuts.push_back({ source, { out.neighbour, shortcutWeight, node } });
+			}
+		}
+	};
+
+	// edge difference plus contracted neighbours, so contractions spread evenly over the graph
+	auto getPriority = [&](const uint32_t node)
+	{
+		findShortcuts(node);
+		return (float)shortcuts.size() - (float)(incoming[node].size() + outgoing[node].size()) + contractedNeighbours[node];
+	};
+
+	IndexedHeap<float> queue;
+	queue.reset(indexCount);
+	for (uint32_t index = 0; index < indexCount; index++) queue.push(index, getPriority(index));
+
+	ranks.assign(indexCount, INVALID_INDEX);
+	uint32_t rank = 0;
+	while (!queue.empty())
+	{
+		// priorities of waiting nodes are only refreshed when they come up, a node that got more important goes back into the queue
+		const uint32_t node = queue.pop();
+		const float priority = getPriority(node);
+		if (!queue.empty() && priority > queue.topKey())
+		{
+			queue.push(node, priority);
+			continue;
+		}
+
+		ranks[node] = rank++;
+		for (const auto& [from, edge] : shortcuts)
+		{
+			improveEdge(outgoing[from], edge.neighbour, edge.weight, edge.middle);
+			improveEdge(incoming[edge.neighbour], from, edge.weight, edge.middle);
+		}
+
+		for (const HierarchyEdge& edge : outgoing[node])
+		{
+			erase_if(incoming[edge.neighbour], [node](const HierarchyEdge& other) { return other.neighbour == node; });
+			contractedNeighbours[edge.neighbour]++;
+		}
+		for (const HierarchyEdge& edge : incoming[node])
+		{
+			erase_if(outgoing[edge.neighbour], [node](const HierarchyEdge& other) { return other.neighbour == node; });
+			contractedNeighbours[edge.neighbour]++;
+		}
+	}
+
+	// all neighbours left in the lists of a node were contracted after it
+	upwardOffsets.reserve((size_t)indexCount + 1);
+	downwardOffsets.reserve((size_t)indexCount + 1);
+	for (uint32_t index = 0; index < indexCount; index++)
+	{
+		upwardOffsets.push_back((uint32_t)upwardEdges.size());
+		downwardOffsets.push_back((uint32_t)downwardEdges.size());
+		upwardEdges.insert(upwardEdges.end(), outgoing[index].begin(), outgoing[index].end());
+		downwardEdges.insert(downwardEdges.end(), incoming[index].begin(), incoming[index].end());
+	}
+	upwardOffsets.push_back((uint32_t)upwardEdges.size());
+	downwardOffsets.push_back((uint32_t)downwardEdges.size());
+
+	auto isShortcut = [](const HierarchyEdge& edge) { return edge.middle != INVALID_INDEX; };
+	shortcutCount = count_if(upwardEdges.begin(), upwardEdges.end(), isShortcut) + count_if(downwardEdges.begin(), downwardEdges.end(), isShortcut);
+	preprocessingTime = high_resolution_clock().now() - startTime;
+}
+
+const ContractionHierarchy::HierarchyEdge* ContractionHierarchy::findEdge(const uint32_t from, const uint32_t to) const
+{
+	// edges are stored at their lower ranked node
+	const EdgeRange edges = ranks[from] < ranks[to] ? getUpwardEdges(from) : getDownwardEdges(to);
+	const uint32_t neighbour = ranks[from] < ranks[to] ? to : from;
+	for (auto iter = edges.begin(); iter != edges.end(); ++iter)
+	{
+		if (iter.edge->neighbour == neighbour) return iter.edge;
+	}
+
+	throw std::exception("ContractionHierarchy has no edge between the given nodes.");
+}
+
+size_t ContractionHierarchy::getMemoryUsage() const
+{
+	return ranks.size() * sizeof(uint32_t) + (upwardOffsets.size() + downwardOffsets.size()) * sizeof(uint32_t) + getEdgeCount() * sizeof(HierarchyEdge);
+}
+
+void ContractionHierarchy::unpackEdge(const uint32_t from, const uint32_t to, std::vector<uint32_t>& indexPath) const
+{
+	// shortcuts are split at their middle node until only original edges are left, the second halves wait on the stack
+	std::vector<std::pair<uint32_t, uint32_t>> pending { { from, to } };
+	while (!pending.empty())
+	{
+		const auto [first, second] = pending.back();
+		pending.pop_back();
+
+		const HierarchyEdge* edge = findEdge(first, second);
+		if (edge->middle == INVALID_INDEX)
+		{
+			indexPath.push_back(second);
+			continue;
+		}
+
+		pending.push_back({ edge->middle, second });
+		pending.push_back({ first, edge->middle });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <chrono>
+#include "CompactGraph.h"
+#include "ImplicitGridGraph.h"
+
+namespace Pathfinding
+{
+	// contraction hierarchy of a static graph, nodes are contracted from least to most important
+	// shortcuts keep the distances between the remaining nodes, so every shortest path turns into an upward and a downward part
+	class ContractionHierarchy
+	{
+		public:
+
+		// shortcuts remember the contracted node they skip, original edges have no middle node
+		struct HierarchyEdge
+		{
+			uint32_t neighbour;
+			float weight;
+			uint32_t middle;
+		};
+
+		class EdgeRange
+		{
+			private:
+
+			const HierarchyEdge* first;
+			const HierarchyEdge* last;
+
+			public:
+
+			struct Iterator
+			{
+				const HierarchyEdge* edge;
+
+				IndexedEdge operator*() const { return { edge->neighbour, edge->weight }; }
+				Iterator& operator++() { edge++; return *this; }
+				bool operator!=(const Iterator& other) const { return edge != other.edge; }
+			};
+
+			EdgeRange(const HierarchyEdge* first, const HierarchyEdge* last) : first(first), last(last) {}
+
+			Iterator begin() const { return { first }; }
+			Iterator end() const { return { last }; }
+			size_t size() const { return last - first; }
+		};
+
+		private:
+
+		std::vector<uint32_t> ranks;
+		std::vector<uint32_t> upwardOffsets;
+		std::vector<HierarchyEdge> upwardEdges;
+		std::vector<uint32_t> downwardOffsets;
+		std::vector<HierarchyEdge> downwardEdges;
+
+		size_t shortcutCount = 0;
+		std::chrono::nanoseconds preprocessingTime = std::chrono::nanoseconds::zero();
+
+		template<typename GraphType>
+		void build(const GraphType& graph, const size_t witnessLimit);
+
+		const HierarchyEdge* findEdge(const uint32_t from, const uint32_t to) const;
+
+		public:
+
+		// witness searches give up after settling witnessLimit nodes, lower limits build faster but add more shortcuts
+		ContractionHierarchy(const Graph& graph, const size_t witnessLimit = 500);
+		ContractionHierarchy(const ImplicitGridGraph& graph, const size_t witnessLimit = 500);
+
+		size_t getIndexCount() const { return ranks.size(); }
+		size_t getEdgeCount() const { return upwardEdges.size() + downwardEdges.size(); }
+		size_t getShortcutCount() const { return shortcutCount; }
+		size_t getMemoryUsage() const;
+		std::chrono::nanoseconds getPreprocessingTime() const { return preprocessingTime; }
+		uint32_t getRank(const uint32_t index) const { return ranks[index]; }
+
+		// edges to higher ranked nodes, and the reversed edges reaching a node from higher ranked nodes
+		EdgeRange getUpwardEdges(const uint32_t index) const { return EdgeRange(upwardEdges.data() + upwardOffsets[index], upwardEdges.data() + upwardOffsets[(size_t)index + 1]); }
+		EdgeRange getDownwardEdges(const uint32_t index) const { return EdgeRange(downwardEdges.data() + downwardOffsets[index], downwardEdges.data() + downwardOffsets[(size_t)index + 1]); }
+
+		// appends the original nodes of the hierarchy edge from -> to, without from itself
+		void unpackEdge(const uint32_t from, const uint32_t to, std::vector<uint32_t>& indexPath) const;
+	};
+}
\ No newline at end of file
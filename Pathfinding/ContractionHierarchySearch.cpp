@@ -0,0 +1,239 @@
+#include "ContractionHierarchySearch.h"
+
+using namespace Pathfinding;
+
+template<typename GraphType, typename Edges, typename StallEdges, typename Recorder>
+void ContractionHierarchySearch::expand(const GraphType& graph, const Edges& edges, const StallEdges& stallEdges, SearchWorkspace& workspace, const SearchWorkspace& opposite, const uint32_t current, Meeting& meeting, const Recorder& record) const
+{
+	// if a higher ranked node reaches current cheaper, no shortest path continues upwards from here
+	for (const auto [neighbour, weight] : stallEdges.getEdges(current))
+	{
+		if (workspace.isKnown(neighbour) && workspace[neighbour].pathWeight + weight < workspace[current].pathWeight) return;
+	}
+
+	for (const auto [neighbour, weight] : edges.getEdges(current))
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new neighbours of current node
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight);
+			workspace.pathWeightHeap.push(neighbour, neighbourPathWeight);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of neighbour is worse than current path -> replace pathData and move neighbour up in the queue
+		else if (!workspace[neighbour].explored && workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace.pathWeightHeap.decrease(neighbour, neighbourPathWeight);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		else continue;
+
+		// if the other search already reached the neighbour -> both halves form a path, keep the best one
+		if (opposite.isKnown(neighbour) && neighbourPathWeight + opposite[neighbour].pathWeight < meeting.pathWeight)
+		{
+			meeting = { neighbourPathWeight + opposite[neighbour].pathWeight, neighbour };
+		}
+	}
+}
+
+template<typename GraphType>
+SearchResult ContractionHierarchySearch::buildResult(const GraphType& graph, const ContractionHierarchy& hierarchy, const SearchWorkspace& workspace, const SearchWorkspace& backward, const Meeting& meeting, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+{
+	// walk back to the start node, then follow the backward search to the end node
+	std::vector<uint32_t> hierarchyPath;
+	for (uint32_t current = meeting.index; current != INVALID_INDEX; current = workspace[current].previous)
+	{
+		hierarchyPath.push_back(current);
+	}
+	std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+
+	for (uint32_t current = backward[meeting.index].previous; current != INVALID_INDEX; current = backward[current].previous)
+	{
+		hierarchyPath.push_back(current);
+	}
+
+	// replace every shortcut by the original edges it stands for
+	std::vector<uint32_t> indexPath { hierarchyPath.front() };
+	for (size_t i = 1; i < hierarchyPath.size(); i++)
+	{
+		hierarchy.unpackEdge(hierarchyPath[i - 1], hierarchyPath[i], indexPath);
+	}
+
+	std::list<const Node*> path;
+	if constexpr (requires { graph.nodeAt(meeting.index); })
+	{
+		for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+	}
+
+	return SearchResult(true, meeting.pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+}
+
+template<typename GraphType>
+Coroutine ContractionHierarchySearch::searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	nanoseconds runtime = nanoseconds::zero();
+	auto startTime = high_resolution_clock().now();
+
+	// the hierarchy is read on the first resume, environments assign it after creating the search
+	if (!hierarchy || hierarchy->getIndexCount() != graph.getIndexCount())
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("ContractionHierarchySearch was run without assigning the contraction hierarchy of the graph first.");
+	}
+	const shared_ptr<const ContractionHierarchy> searchHierarchy = hierarchy;
+	const UpwardEdges upward { *searchHierarchy };
+	const DownwardEdges downward { *searchHierarchy };
+
+	const SearchRecorder<PathData> record { searchLog };
+	const float infinity = numeric_limits<float>::infinity();
+	Meeting meeting;
+	size_t exploredCount = 0;
+	size_t previousSearchLogSize;
+
+	SearchWorkspace& backward = workspace.getBackward();
+	workspace.reset(graph.getIndexCount());
+	backward.reset(graph.getIndexCount());
+	auto& forwardDiscovered = workspace.pathWeightHeap;
+	auto& backwardDiscovered = backward.pathWeightHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	forwardDiscovered.push(start, 0);
+	backward.discover(end, INVALID_INDEX, 0);
+	backwardDiscovered.push(end, 0);
+	if (start == end) meeting = { 0, start };
+
+	while (true)
+	{
+		// both searches only go upwards, so each one runs until its own frontier can not beat the best meeting
+		const float forwardKey = forwardDiscovered.empty() ? infinity : forwardDiscovered.topKey();
+		const float backwardKey = backwardDiscovered.empty() ? infinity : backwardDiscovered.topKey();
+		if (min(forwardKey, backwardKey) >= meeting.pathWeight) break;
+
+		// grow the search with the smaller frontier key
+		const bool forwardStep = forwardKey <= backwardKey;
+		SearchWorkspace& stepWorkspace = forwardStep ? workspace : backward;
+		const uint32_t current = forwardStep ? forwardDiscovered.pop() : backwardDiscovered.pop();
+		record(graph, stepWorkspace, current, NodeState::CURRENT);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if(&incrementalSearch);
+		startTime = high_resolution_clock().now();
+		previousSearchLogSize = searchLog.size();
+
+		stepWorkspace[current].explored = true;
+		if (forwardStep) expand(graph, upward, downward, workspace, backward, current, meeting, record);
+		else expand(graph, downward, upward, backward, workspace, current, meeting, record);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
+		startTime = high_resolution_clock().now();
+
+		exploredCount++;
+		record(graph, stepWorkspace, current, NodeState::PROCESSED);
+	}
+
+	runtime += high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (meeting.index == INVALID_INDEX)
+	{
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
+		co_return;
+	}
+
+	searchResult = make_shared<SearchResult>(buildResult(graph, *searchHierarchy, workspace, backward, meeting, exploredCount, runtime));
+}
+
+template<typename GraphType>
+SearchResult ContractionHierarchySearch::runIndexed(const GraphType& graph, const ContractionHierarchy& hierarchy, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	const UpwardEdges upward { hierarchy };
+	const DownwardEdges downward { hierarchy };
+	const float infinity = numeric_limits<float>::infinity();
+	Meeting meeting;
+	size_t exploredCount = 0;
+
+	SearchWorkspace& backward = workspace.getBackward();
+	workspace.reset(graph.getIndexCount());
+	backward.reset(graph.getIndexCount());
+	auto& forwardDiscovered = workspace.pathWeightHeap;
+	auto& backwardDiscovered = backward.pathWeightHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	forwardDiscovered.push(start, 0);
+	backward.discover(end, INVALID_INDEX, 0);
+	backwardDiscovered.push(end, 0);
+	if (start == end) meeting = { 0, start };
+
+	while (true)
+	{
+		const float forwardKey = forwardDiscovered.empty() ? infinity : forwardDiscovered.topKey();
+		const float backwardKey = backwardDiscovered.empty() ? infinity : backwardDiscovered.topKey();
+		if (min(forwardKey, backwardKey) >= meeting.pathWeight) break;
+
+		if (forwardKey <= backwardKey)
+		{
+			const uint32_t current = forwardDiscovered.pop();
+			workspace[current].explored = true;
+			expand(graph, upward, downward, workspace, backward, current, meeting, NullRecorder {});
+		}
+		else
+		{
+			const uint32_t current = backwardDiscovered.pop();
+			backward[current].explored = true;
+			expand(graph, downward, upward, backward, workspace, current, meeting, NullRecorder {});
+		}
+		exploredCount++;
+	}
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (meeting.index == INVALID_INDEX) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, hierarchy, workspace, backward, meeting, exploredCount, runtime);
+}
+
+Coroutine ContractionHierarchySearch::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+Coroutine ContractionHierarchySearch::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+SearchResult ContractionHierarchySearch::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!hierarchy || hierarchy->getIndexCount() != graph.getIndexCount()) throw std::exception("ContractionHierarchySearch was run without assigning the contraction hierarchy of the graph first.");
+	return runIndexed(graph, *hierarchy, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult ContractionHierarchySearch::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!hierarchy || hierarchy->getIndexCount() != graph.getIndexCount()) throw std::exception("ContractionHierarchySearch was run without assigning the contraction hierarchy of the graph first.");
+	return runIndexed(graph, *hierarchy, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult ContractionHierarchySearch::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	if (!hierarchy || hierarchy->getIndexCount() != graph.getIndexCount()) throw std::exception("ContractionHierarchySearch was run without assigning the contraction hierarchy of the graph first.");
+	return runIndexed(graph, *hierarchy, start, end, workspace);
+}
\ No newline at end of file
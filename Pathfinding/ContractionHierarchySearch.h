@@ -0,0 +1,62 @@
+#pragma once
+#include "ContractionHierarchy.h"
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	// bidirectional Dijkstra on a contraction hierarchy, both searches only follow edges to higher ranked nodes
+	// nodes reached cheaper from a higher ranked node are stalled, shortcuts on the found path are unpacked into original edges
+	class ContractionHierarchySearch : public Pathfinder
+	{
+		private:
+
+		struct Meeting
+		{
+			float pathWeight = std::numeric_limits<float>::infinity();
+			uint32_t index = INVALID_INDEX;
+		};
+
+		// each search walks one half of the hierarchy and checks the other half for stalling
+		struct UpwardEdges
+		{
+			const ContractionHierarchy& hierarchy;
+
+			ContractionHierarchy::EdgeRange getEdges(const uint32_t index) const { return hierarchy.getUpwardEdges(index); }
+		};
+
+		struct DownwardEdges
+		{
+			const ContractionHierarchy& hierarchy;
+
+			ContractionHierarchy::EdgeRange getEdges(const uint32_t index) const { return hierarchy.getDownwardEdges(index); }
+		};
+
+		template<typename GraphType, typename Edges, typename StallEdges, typename Recorder>
+		void expand(const GraphType& graph, const Edges& edges, const StallEdges& stallEdges, SearchWorkspace& workspace, const SearchWorkspace& opposite, const uint32_t current, Meeting& meeting, const Recorder& record) const;
+
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, const ContractionHierarchy& hierarchy, const SearchWorkspace& workspace, const SearchWorkspace& backward, const Meeting& meeting, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const;
+
+		template<typename GraphType>
+		Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType>
+		SearchResult runIndexed(const GraphType& graph, const ContractionHierarchy& hierarchy, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const;
+
+		protected:
+
+		std::shared_ptr<const ContractionHierarchy> hierarchy;
+
+		public:
+
+		// the hierarchy has to be built from the searched graph, it is shared between all searches using it
+		virtual void setHierarchy(std::shared_ptr<const ContractionHierarchy> hierarchy) { this->hierarchy = move(hierarchy); }
+		const std::shared_ptr<const ContractionHierarchy>& getHierarchy() const { return hierarchy; }
+
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "DStarLite.h"
+
+using namespace Pathfinding;
+
+std::pair<float, float> DStarLite::calculateKey(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const
+{
+	// the key modifier makes up for the heuristic shrinking while the start moves, so queued keys stay lower bounds
+	const float cost = std::min(plan.g[index], plan.rhs[index]);
+	return { cost + grid.getDistanceEstimate(plan.start, index) + plan.keyModifier, cost };
+}
+
+float DStarLite::lookAhead(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const
+{
+	float cost = std::numeric_limits<float>::infinity();
+	for (const auto [neighbour, weight] : grid.getEdges(index)) cost = std::min(cost, weight + plan.g[neighbour]);
+	return cost;
+}
+
+uint32_t DStarLite::getNextStep(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const
+{
+	uint32_t next = INVALID_INDEX;
+	float cost = std::numeric_limits<float>::infinity();
+	for (const auto [neighbour, weight] : grid.getEdges(index))
+	{
+		if (weight + plan.g[neighbour] < cost)
+		{
+			cost = weight + plan.g[neighbour];
+			next = neighbour;
+		}
+	}
+	return next;
+}
+
+void DStarLite::updateNode(const ImplicitGridGraph& grid, Plan& plan, const uint32_t index) const
+{
+	const bool inconsistent = plan.g[index] != plan.rhs[index];
+	if (plan.open.contains(index))
+	{
+		if (inconsistent) plan.open.update(index, calculateKey(grid, plan, index));
+		else plan.open.erase(index);
+	}
+	else if (inconsistent) plan.open.push(index, calculateKey(grid, plan, index));
+}
+
+void DStarLite::refreshNode(const ImplicitGridGraph& grid, Plan& plan, const uint32_t index) const
+{
+	if (index != plan.end) plan.rhs[index] = lookAhead(grid, plan, index);
+	updateNode(grid, plan, index);
+}
+
+void DStarLite::initialize(const ImplicitGridGraph& grid, Plan& plan, const uint32_t start, const uint32_t end) const
+{
+	const size_t indexCount = grid.getIndexCount();
+	plan.start = start;
+	plan.end = end;
+	plan.keyModifier = 0;
+	plan.g.assign(indexCount, std::numeric_limits<float>::infinity());
+	plan.rhs.assign(indexCount, std::numeric_limits<float>::infinity());
+	plan.open.reset(indexCount);
+
+	plan.rhs[end] = 0;
+	plan.open.push(end, calculateKey(grid, plan, end));
+}
+
+bool DStarLite::needsExpansion(const ImplicitGridGraph& grid, const Plan& plan) const
+{
+	// the start is final once it is consistent and no queued node could still lower its cost
+	return !plan.open.empty() && (plan.open.topKey() < calculateKey(grid, plan, plan.start) || plan.rhs[plan.start] > plan.g[plan.start]);
+}
+
+template<typename Recorder>
+bool DStarLite::expandNext(const ImplicitGridGraph& grid, Plan& plan, const Recorder& record) const
+{
+	const uint32_t current = plan.open.top();
+	const std::pair<float, float> key = calculateKey(grid, plan, current);
+	if (plan.open.topKey() < key)
+	{
+		plan.open.update(current, key);
+		return false;
+	}
+
+	// cost went down -> take it over and offer it to the predecessors
+	if (plan.g[current] > plan.rhs[current])
+	{
+		plan.g[current] = plan.rhs[current];
+		plan.open.pop();
+		for (const auto [neighbour, weight] : grid.getIncomingEdges(current))
+		{
+			if (neighbour == plan.end || weight + plan.g[current] >= plan.rhs[neighbour]) continue;
+
+			plan.rhs[neighbour] = weight + plan.g[current];
+			updateNode(grid, plan, neighbour);
+			record(neighbour, NodeState::DISCOVERED);
+		}
+		return true;
+	}
+
+	// cost went up -> predecessors that relied on the old cost have to look for another successor
+	const float previousCost = plan.g[current];
+	plan.g[current] = std::numeric_limits<float>::infinity();
+	for (const auto [neighbour, weight] : grid.getIncomingEdges(current))
+	{
+		if (plan.rhs[neighbour] != weight + previousCost) continue;
+
+		refreshNode(grid, plan, neighbour);
+		record(neighbour, NodeState::DISCOVERED);
+	}
+	refreshNode(grid, plan, current);
+	return true;
+}
+
+template<typename GraphType>
+SearchResult DStarLite::buildResult(const GraphType& graph, const ImplicitGridGraph& grid, const Plan& plan, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+{
+	// no path found
+	if (plan.rhs[plan.start] == std::numeric_limits<float>::infinity()) return SearchResult(nodesExplored, runtime);
+
+	// every step follows the cheapest successor, the weight is summed from the start like forward searches do
+	std::vector<uint32_t> indexPath { plan.start };
+	float pathWeight = 0;
+	for (uint32_t current = plan.start; current != plan.end;)
+	{
+		const uint32_t next = getNextStep(grid, plan, current);
+		if (next == INVALID_INDEX || indexPath.size() > grid.getIndexCount()) return SearchResult(nodesExplored, runtime);
+
+		for (const auto [neighbour, weight] : grid.getEdges(current))
+		{
+			if (neighbour == next) pathWeight += weight;
+		}
+		indexPath.push_back(current = next);
+	}
+
+	std::list<const Node*> path;
+	if constexpr (requires { graph.nodeAt(plan.start); })
+	{
+		for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+	}
+
+	return SearchResult(true, pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+}
+
+template<typename GraphType>
+Coroutine DStarLite::searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, bool& incrementalSearch)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	nanoseconds runtime = nanoseconds::zero();
+	auto startTime = high_resolution_clock().now();
+
+	// the layout is read on the first resume, environments assign it after creating the search
+	if (!layout || layout->getIndexCount() != graph.getIndexCount())
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("DStarLite was run without assigning the grid layout of the graph first.");
+	}
+	if (!hasLayoutWeights(graph))
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("DStarLite takes its weights from the layout, it can not search graphs whose weights changed.");
+	}
+	const shared_ptr<const ImplicitGridGraph> grid = layout;
+
+	Plan plan;
+	initialize(*grid, plan, start, end);
+
+	// nodes point at their cheapest successor, which is the next step towards the end node
+	auto record = [&](const uint32_t index, const NodeState state)
+	{
+		const uint32_t next = index != plan.end ? getNextStep(*grid, plan, index) : INVALID_INDEX;
+		const Node* nextNode = next != INVALID_INDEX ? graph.nodeAt(next) : nullptr;
+		searchLog.push_back({ graph.nodeAt(index), state, make_shared<PathData>(nextNode, min(plan.g[index], plan.rhs[index])) });
+	};
+
+	size_t exploredCount = 0;
+	size_t previousSearchLogSize;
+
+	while (needsExpansion(*grid, plan))
+	{
+		const uint32_t current = plan.open.top();
+		record(current, NodeState::CURRENT);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if(&incrementalSearch);
+		startTime = high_resolution_clock().now();
+		previousSearchLogSize = searchLog.size();
+
+		if (!expandNext(*grid, plan, record)) continue;
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
+		startTime = high_resolution_clock().now();
+
+		exploredCount++;
+		if (plan.g[current] == plan.rhs[current]) record(current, NodeState::PROCESSED);
+	}
+
+	runtime += high_resolution_clock().now() - startTime;
+	searchResult = make_shared<SearchResult>(buildResult(graph, *grid, plan, exploredCount, runtime));
+}
+
+template<typename GraphType>
+SearchResult DStarLite::runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, Plan& plan, const std::chrono::high_resolution_clock::time_point startTime) const
+{
+	using namespace std::chrono;
+
+	size_t exploredCount = 0;
+	while (needsExpansion(grid, plan))
+	{
+		if (expandNext(grid, plan, [](const uint32_t, const NodeState) {})) exploredCount++;
+	}
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+	return buildResult(graph, grid, plan, exploredCount, runtime);
+}
+
+void DStarLite::setLayout(std::shared_ptr<const ImplicitGridGraph> layout)
+{
+	this->layout = move(layout);
+	activePlan = Plan();
+}
+
+SearchResult DStarLite::plan(const uint32_t start, const uint32_t end)
+{
+	if (!layout) throw std::exception("DStarLite was run without assigning the grid layout first.");
+
+	const auto startTime = std::chrono::high_resolution_clock().now();
+	initialize(*layout, activePlan, start, end);
+	return runIndexed(*layout, *layout, activePlan, startTime);
+}
+
+void DStarLite::updateEdges(const std::vector<std::pair<uint32_t, uint32_t>>& changedEdges)
+{
+	if (!layout || activePlan.end == INVALID_INDEX) return;
+
+	// only the cost seen from the tail of an edge depends on its weight
+	for (const auto& [from, to] : changedEdges) refreshNode(*layout, activePlan, from);
+}
+
+void DStarLite::updateCells(const std::vector<uint32_t>& changedCells)
+{
+	if (!layout || activePlan.end == INVALID_INDEX) return;
+
+	for (const uint32_t cell : changedCells)
+	{
+		refreshNode(*layout, activePlan, cell);
+		for (const auto [neighbour, weight] : layout->getIncomingEdges(cell)) refreshNode(*layout, activePlan, neighbour);
+	}
+}
+
+SearchResult DStarLite::replan(const uint32_t start)
+{
+	if (!layout) throw std::exception("DStarLite was run without assigning the grid layout first.");
+	if (activePlan.end == INVALID_INDEX) throw std::exception("DStarLite has to plan a path before it can replan it.");
+
+	const auto startTime = std::chrono::high_resolution_clock().now();
+	activePlan.keyModifier += layout->getDistanceEstimate(activePlan.start, start);
+	activePlan.start = start;
+	return runIndexed(*layout, *layout, activePlan, startTime);
+}
+
+Coroutine DStarLite::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace&, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), incrementalSearch);
+}
+
+Coroutine DStarLite::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace&, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), incrementalSearch);
+}
+
+SearchResult DStarLite::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace&) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("DStarLite was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("DStarLite takes its weights from the layout, it can not search graphs whose weights changed.");
+
+	const auto startTime = std::chrono::high_resolution_clock().now();
+	Plan plan;
+	initialize(*layout, plan, start.getIndex(), end.getIndex());
+	return runIndexed(graph, *layout, plan, startTime);
+}
+
+SearchResult DStarLite::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace&) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("DStarLite was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("DStarLite takes its weights from the layout, it can not search graphs whose weights changed.");
+
+	const auto startTime = std::chrono::high_resolution_clock().now();
+	Plan plan;
+	initialize(*layout, plan, start.getIndex(), end.getIndex());
+	return runIndexed(graph, *layout, plan, startTime);
+}
+
+SearchResult DStarLite::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace&) const
+{
+	// implicit grids are their own layout
+	const auto startTime = std::chrono::high_resolution_clock().now();
+	Plan plan;
+	initialize(graph, plan, start, end);
+	return runIndexed(graph, graph, plan, startTime);
+}
\ No newline at end of file
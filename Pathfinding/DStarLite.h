@@ -0,0 +1,72 @@
+#pragma once
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	// D* Lite, searches backwards from the end node so the costs of all searched nodes to the end stay valid while the start moves
+	// after edge weights of the layout changed, only nodes whose cost depends on the changed edges are searched again
+	class DStarLite : public Pathfinder
+	{
+		private:
+
+		// g is the cost to the end found by the last expansion of a node, rhs the cost seen from its successors
+		// nodes where both differ are inconsistent and wait in the open list
+		struct Plan
+		{
+			uint32_t start = INVALID_INDEX, end = INVALID_INDEX;
+			float keyModifier = 0;
+			std::vector<float> g, rhs;
+			IndexedHeap<std::pair<float, float>> open;
+		};
+
+		Plan activePlan;
+
+		std::pair<float, float> calculateKey(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const;
+		float lookAhead(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const;
+		uint32_t getNextStep(const ImplicitGridGraph& grid, const Plan& plan, const uint32_t index) const;
+		void updateNode(const ImplicitGridGraph& grid, Plan& plan, const uint32_t index) const;
+		void refreshNode(const ImplicitGridGraph& grid, Plan& plan, const uint32_t index) const;
+		void initialize(const ImplicitGridGraph& grid, Plan& plan, const uint32_t start, const uint32_t end) const;
+		bool needsExpansion(const ImplicitGridGraph& grid, const Plan& plan) const;
+
+		// handles the top of the open list, returns false if it only had an outdated key
+		template<typename Recorder>
+		bool expandNext(const ImplicitGridGraph& grid, Plan& plan, const Recorder& record) const;
+
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, const ImplicitGridGraph& grid, const Plan& plan, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const;
+
+		template<typename GraphType>
+		Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, bool& incrementalSearch);
+
+		template<typename GraphType>
+		SearchResult runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, Plan& plan, const std::chrono::high_resolution_clock::time_point startTime) const;
+
+		protected:
+
+		std::shared_ptr<const ImplicitGridGraph> layout;
+
+		public:
+
+		// graphs have to be built from the layout with matching indices, assigning a layout drops the current plan
+		virtual void setLayout(std::shared_ptr<const ImplicitGridGraph> layout);
+
+		// searches the layout from scratch and keeps the costs for later replans
+		SearchResult plan(const uint32_t start, const uint32_t end);
+
+		// have to be called after weights of the layout changed, edges are given as pairs of from and to index
+		// a changed cell height changes all edges into and out of the cell
+		void updateEdges(const std::vector<std::pair<uint32_t, uint32_t>>& changedEdges);
+		void updateCells(const std::vector<uint32_t>& changedCells);
+
+		// repairs the costs of the current plan and returns the path from the new start, which may be any node
+		SearchResult replan(const uint32_t start);
+
+		// every call plans from scratch without touching the current plan, the workspace is not used
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "DeltaStepping.h"
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <thread>
+
+using namespace Pathfinding;
+
+// distance and predecessor share one atomic word, non-negative floats order like their bit patterns so the distance sits in the high half
+static uint64_t pack(const float distance, const uint32_t previous)
+{
+	return ((uint64_t)std::bit_cast<uint32_t>(distance) << 32) | previous;
+}
+
+static float unpackDistance(const uint64_t packed)
+{
+	return std::bit_cast<float>((uint32_t)(packed >> 32));
+}
+
+DeltaStepping::DeltaStepping(const size_t threadCount, const float delta) : threadCount(threadCount), delta(delta)
+{
+	if (this->threadCount == 0) this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+	if (delta < 0) throw std::exception("DeltaStepping needs a positive bucket width.");
+}
+
+template<typename GraphType>
+DistanceField DeltaStepping::runIndexed(const GraphType& graph, const uint32_t source) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+	const size_t indexCount = graph.getIndexCount();
+
+	// the heaviest edge decides how many buckets can be filled at once, so the buckets are reused cyclically
+	float maxWeight = 0;
+	double weightSum = 0;
+	size_t edgeCount = 0;
+	for (uint32_t index = 0; index < indexCount; index++)
+	{
+		if constexpr (requires { graph.nodeAt(index); })
+		{
+			if (!graph.nodeAt(index)) continue;
+		}
+
+		for (const auto [neighbour, weight] : graph.getEdges(index))
+		{
+			if (weight < 0) throw exception("DeltaStepping does not support negative edge weights.");
+			maxWeight = max(maxWeight, weight);
+			weightSum += weight;
+			edgeCount++;
+		}
+	}
+	float bucketWidth = delta > 0 ? delta : edgeCount > 0 ? (float)(weightSum / edgeCount) : 1.0f;
+	if (bucketWidth <= 0) bucketWidth = 1;
+	const size_t bucketCount = (size_t)(maxWeight / bucketWidth) + 2;
+	auto getBucket = [bucketWidth](const float distance) { return (size_t)(distance / bucketWidth); };
+
+	vector<atomic<uint64_t>> packed(indexCount);
+	for (atomic<uint64_t>& slot : packed) slot.store(pack(numeric_limits<float>::infinity(), INVALID_INDEX), memory_order_relaxed);
+	packed[source].store(pack(0, INVALID_INDEX), memory_order_relaxed);
+
+	// every thread files the nodes it improved into its own buckets, the coordinating step merges them between phases
+	vector<vector<vector<uint32_t>>> threadBuckets(threadCount, vector<vector<uint32_t>>(bucketCount));
+	threadBuckets[0][0].push_back(source);
+
+	// starting as if the bucket before the first one was just finished, so the first coordinating step gathers the source
+	enum class Phase { Light, Heavy, Done };
+	Phase phase = Phase::Heavy;
+	size_t currentBucket = (size_t)-1;
+	vector<uint32_t> frontier, settled;
+	vector<uint32_t> frontierStamps(indexCount, 0);
+	vector<size_t> settledStamps(indexCount, 0);
+	uint32_t frontierStamp = 0;
+	atomic<size_t> nextChunk = 0;
+
+	// merges the current bucket of all threads, stale entries whose distance moved to a lower bucket were already handled there
+	auto gatherFrontier = [&]()
+	{
+		frontier.clear();
+		frontierStamp++;
+		for (vector<vector<uint32_t>>& buckets : threadBuckets)
+		{
+			vector<uint32_t>& bucket = buckets[currentBucket % bucketCount];
+			for (const uint32_t index : bucket)
+			{
+				if (frontierStamps[index] == frontierStamp || getBucket(unpackDistance(packed[index].load(memory_order_relaxed))) != currentBucket) continue;
+				frontierStamps[index] = frontierStamp;
+				frontier.push_back(index);
+				if (settledStamps[index] != currentBucket + 1)
+				{
+					settledStamps[index] = currentBucket + 1;
+					settled.push_back(index);
+				}
+			}
+			bucket.clear();
+		}
+	};
+
+	// runs alone whenever all threads finished a phase, it decides what the next phase works on
+	auto coordinate = [&]() noexcept
+	{
+		if (phase == Phase::Heavy)
+		{
+			settled.clear();
+			size_t step = 1;
+			for (; step < bucketCount; step++)
+			{
+				const size_t bucket = (currentBucket + step) % bucketCount;
+				if (any_of(threadBuckets.begin(), threadBuckets.end(), [bucket](const vector<vector<uint32_t>>& buckets) { return !buckets[bucket].empty(); })) break;
+			}
+			if (step == bucketCount)
+			{
+				phase = Phase::Done;
+				return;
+			}
+			currentBucket += step;
+		}
+
+		gatherFrontier();
+		if (frontier.empty())
+		{
+			// the bucket stays empty, every node settled in it relaxes its heavy edges once
+			phase = Phase::Heavy;
+			frontier.swap(settled);
+		}
+		else phase = Phase::Light;
+		nextChunk.store(0, memory_order_relaxed);
+	};
+
+	barrier phaseBarrier((ptrdiff_t)threadCount, coordinate);
+
+	auto work = [&](const size_t thread)
+	{
+		constexpr size_t chunkSize = 256;
+		vector<vector<uint32_t>>& buckets = threadBuckets[thread];
+
+		auto relax = [&](const uint32_t neighbour, const float neighbourPathWeight, const uint32_t current)
+		{
+			const uint64_t improved = pack(neighbourPathWeight, current);
+			uint64_t known = packed[neighbour].load(memory_order_relaxed);
+			while (neighbourPathWeight < unpackDistance(known))
+			{
+				if (packed[neighbour].compare_exchange_weak(known, improved, memory_order_relaxed))
+				{
+					buckets[getBucket(neighbourPathWeight) % bucketCount].push_back(neighbour);
+					return;
+				}
+			}
+		};
+
+		phaseBarrier.arrive_and_wait();
+		while (phase != Phase::Done)
+		{
+			const bool light = phase == Phase::Light;
+			for (size_t first = nextChunk.fetch_add(chunkSize); first < frontier.size(); first = nextChunk.fetch_add(chunkSize))
+			{
+				const size_t last = min(first + chunkSize, frontier.size());
+				for (size_t i = first; i < last; i++)
+				{
+					// only the source and nodes reached over an edge get here, so holes of removed nodes are never relaxed
+					const uint32_t current = frontier[i];
+					const float pathWeight = unpackDistance(packed[current].load(memory_order_relaxed));
+					for (const auto [neighbour, weight] : graph.getEdges(current))
+					{
+						if ((weight <= bucketWidth) == light) relax(neighbour, pathWeight + weight, current);
+					}
+				}
+			}
+			phaseBarrier.arrive_and_wait();
+		}
+	};
+
+	// the calling thread is worker 0
+	{
+		vector<jthread> workers;
+		for (size_t thread = 1; thread < threadCount; thread++) workers.emplace_back(work, thread);
+		work(0);
+	}
+
+	DistanceField field;
+	field.source = source;
+	field.distances.resize(indexCount);
+	field.previous.resize(indexCount);
+	for (size_t index = 0; index < indexCount; index++)
+	{
+		const uint64_t slot = packed[index].load(memory_order_relaxed);
+		field.distances[index] = unpackDistance(slot);
+		field.previous[index] = (uint32_t)slot;
+	}
+	field.runtime = high_resolution_clock().now() - startTime;
+	return field;
+}
+
+DistanceField DeltaStepping::run(const Graph& graph, const Node& source) const
+{
+	return runIndexed(graph, source.getIndex());
+}
+
+DistanceField DeltaStepping::run(const CompactGraph& graph, const Node& source) const
+{
+	return runIndexed(graph, source.getIndex());
+}
+
+DistanceField DeltaStepping::run(const ImplicitGridGraph& graph, const uint32_t source) const
+{
+	return runIndexed(graph, source);
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "CompactGraph.h"
+#include "DistanceField.h"
+#include "ImplicitGridGraph.h"
+
+namespace Pathfinding
+{
+	// parallel one-to-all shortest paths, nodes are kept in buckets of width delta and each bucket is settled by all threads together
+	// edges up to delta may put nodes back into the current bucket and are relaxed until it stays empty, heavier edges once per bucket
+	class DeltaStepping
+	{
+		private:
+
+		size_t threadCount;
+		float delta;
+
+		template<typename GraphType>
+		DistanceField runIndexed(const GraphType& graph, const uint32_t source) const;
+
+		public:
+
+		// no thread count uses every hardware thread, no delta uses the average edge weight of the searched graph
+		DeltaStepping(const size_t threadCount = 0, const float delta = 0);
+
+		size_t getThreadCount() const { return threadCount; }
+		float getDelta() const { return delta; }
+
+		DistanceField run(const Graph& graph, const Node& source) const;
+		DistanceField run(const CompactGraph& graph, const Node& source) const;
+		DistanceField run(const ImplicitGridGraph& graph, const uint32_t source) const;
+	};
+}
\ No newline at end of file
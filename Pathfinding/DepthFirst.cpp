@@ -1,10 +1,34 @@
 #include "DepthFirst.h"
-#include <stack>
-#include <set>
 
 using namespace Pathfinding;
 
-Coroutine DepthFirst::search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch)
+template<typename GraphType, typename Recorder>
+void DepthFirst::expand(const GraphType& graph, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const
+{
+	for (const auto [neighbour, weight] : graph.getEdges(current))
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new neighbours of current node
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight);
+			workspace.frontier.push_back(neighbour);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of neighbour is worse than current path -> replace pathData
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			record(graph, workspace, neighbour, workspace[neighbour].explored ? NodeState::PROCESSED : NodeState::DISCOVERED);
+		}
+	}
+}
+
+template<typename GraphType>
+Coroutine DepthFirst::searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch)
 {
 	using namespace std;
 	using namespace std::chrono;
@@ -12,20 +36,22 @@ Coroutine DepthFirst::search(const Graph& graph, const Node& start, const Node&
 	nanoseconds runtime = nanoseconds::zero();
 	auto startTime = high_resolution_clock().now();
 
-	const Node* current = nullptr;
-	stack<const Node*> discovered;
-	set<const Node*> explored;
-	unordered_map<const Node*, PathData> pathData;
+	const SearchRecorder<PathData> record { searchLog };
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
 	size_t previousSearchLogSize;
 
-	discovered.push(&start);
-	pathData.insert({ &start, PathData { nullptr, 0 } });
+	workspace.reset(graph.getIndexCount());
+	vector<uint32_t>& discovered = workspace.frontier;
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	discovered.push_back(start);
 
 	while (!discovered.empty())
 	{
-		current = discovered.top();
-		discovered.pop();
-		searchLog.push_back({ current, NodeState::CURRENT, pathData[current] });
+		current = discovered.back();
+		discovered.pop_back();
+		record(graph, workspace, current, NodeState::CURRENT);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
@@ -34,56 +60,90 @@ Coroutine DepthFirst::search(const Graph& graph, const Node& start, const Node&
 		previousSearchLogSize = searchLog.size();
 
 		// if whole path is found -> break out of loop
-		if (*current == end) break;
+		if (current == end) break;
 
-		for (auto& edge : current->getEdges())
-		{
-			const float neighbourPathWeight = pathData[current].pathWeight + edge->weight;
-			const bool neighbourUnknown = pathData.find(edge->neighbour) == pathData.end();
-			const PathData nodeData{ current, neighbourPathWeight };
-
-			// discover new neighbours of current node
-			if (neighbourUnknown)
-			{
-				discovered.push(edge->neighbour);
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				searchLog.push_back({ edge->neighbour, NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-
-			// if pathWeight of neighbour is worse than current path -> replace pathData
-			else if (pathData[edge->neighbour].pathWeight > neighbourPathWeight)
-			{
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				const bool neighbourExplored = explored.find(edge->neighbour) != explored.end();
-				searchLog.push_back({ edge->neighbour, neighbourExplored ? NodeState::PROCESSED : NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-		}
+		expand(graph, workspace, current, record);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
 		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
 		startTime = high_resolution_clock().now();
 
-		explored.insert(current);
-		searchLog.push_back({ current, NodeState::PROCESSED, pathData[current] });
+		workspace[current].explored = true;
+		exploredCount++;
+		record(graph, workspace, current, NodeState::PROCESSED);
 	}
 
 	runtime += high_resolution_clock().now() - startTime;
 
 	// no path found
-	if (*current != end)
+	if (current != end)
 	{
-		searchResult = make_shared<SearchResult>(explored.size(), runtime);
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
 		co_return;
 	}
 
-	list<const Node*> path;
-	while (current != nullptr)
+	searchResult = make_shared<SearchResult>(buildResult(graph, workspace, end, exploredCount + 1, runtime));
+
+}
+
+template<typename GraphType>
+SearchResult DepthFirst::runIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+
+	workspace.reset(graph.getIndexCount());
+	vector<uint32_t>& discovered = workspace.frontier;
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	discovered.push_back(start);
+
+	while (!discovered.empty())
 	{
-		path.push_front(current);
-		current = pathData[current].previousNode;
+		current = discovered.back();
+		discovered.pop_back();
+		if (current == end) break;
+
+		expand(graph, workspace, current, NullRecorder {});
+		workspace[current].explored = true;
+		exploredCount++;
 	}
 
-	searchResult = make_shared<SearchResult>(true, pathData[&end].pathWeight, move(path), explored.size() + 1, runtime);
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
 
+	// no path found
+	if (current != end) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, workspace, end, exploredCount + 1, runtime);
 }
+
+Coroutine DepthFirst::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+Coroutine DepthFirst::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+SearchResult DepthFirst::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	return runIndexed(graph, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult DepthFirst::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	return runIndexed(graph, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult DepthFirst::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	return runIndexed(graph, start, end, workspace);
+}
\ No newline at end of file
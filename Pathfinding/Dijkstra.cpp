@@ -1,10 +1,57 @@
 #include "Dijkstra.h"
-#include <queue>
-#include <set>
 
 using namespace Pathfinding;
 
-Coroutine Dijkstra::search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch)
+template<typename GraphType, typename Queue, typename Recorder>
+void Dijkstra::expand(const GraphType& graph, Queue& discovered, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const
+{
+	for (const auto [neighbour, weight] : graph.getEdges(current))
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new neighbours of current node
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight);
+			discovered.push(neighbour, neighbourPathWeight);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of neighbour is worse than current path -> replace pathData and move neighbour up in the queue, explored nodes are reopened
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace[neighbour].explored = false;
+			discovered.pushOrDecrease(neighbour, neighbourPathWeight);
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+	}
+}
+
+template<typename GraphType, typename Run>
+auto Dijkstra::runWithQueue(const GraphType& graph, SearchWorkspace& workspace, const Run& run) const
+{
+	// the binary heap is reset together with the workspace, the other queues only when they are chosen
+	const std::optional<uint32_t> weightBound = getIntegerWeightBound(graph);
+	switch (queuePolicy != QueuePolicy::Automatic ? queuePolicy : weightBound ? QueuePolicy::Bucket : QueuePolicy::BinaryHeap)
+	{
+		case QueuePolicy::Bucket:
+			if (!weightBound) throw std::exception("Dijkstra can only use a bucket queue on graphs with bounded integer edge weights.");
+			workspace.pathWeightBuckets.reset(graph.getIndexCount(), *weightBound);
+			return run(workspace.pathWeightBuckets);
+
+		case QueuePolicy::Radix:
+			workspace.pathWeightRadixHeap.reset(graph.getIndexCount());
+			return run(workspace.pathWeightRadixHeap);
+
+		default:
+			return run(workspace.pathWeightHeap);
+	}
+}
+
+template<typename GraphType, typename Targets, typename Queue>
+Coroutine Dijkstra::searchIndexed(const GraphType& graph, const uint32_t start, const Targets targets, Queue& discovered, SearchWorkspace& workspace, bool& incrementalSearch)
 {
 	using namespace std;
 	using namespace std::chrono;
@@ -12,23 +59,20 @@ Coroutine Dijkstra::search(const Graph& graph, const Node& start, const Node& en
 	nanoseconds runtime = nanoseconds::zero();
 	auto startTime = high_resolution_clock().now();
 
-	const Node* current = nullptr;	
-	unordered_map<const Node*, PathData> pathData;
-
-	auto compare = [&](const Node* left, const Node* right) { return pathData[left].pathWeight > pathData[right].pathWeight; };
-
-	priority_queue<const Node*, vector<const Node*>, decltype(compare)> discovered(compare);
-	set<const Node*> explored;
+	const SearchRecorder<PathData> record { searchLog };
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
 	size_t previousSearchLogSize;
 
-	discovered.push(&start);
-	pathData.insert({ &start, PathData { nullptr, 0 } });
+	workspace.reset(graph.getIndexCount());
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	discovered.push(start, 0);
 
 	while (!discovered.empty())
 	{
-		current = discovered.top();
-		discovered.pop();
-		searchLog.push_back({ current, NodeState::CURRENT, pathData[current] });
+		current = discovered.pop();
+		record(graph, workspace, current, NodeState::CURRENT);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
@@ -37,56 +81,148 @@ Coroutine Dijkstra::search(const Graph& graph, const Node& start, const Node& en
 		previousSearchLogSize = searchLog.size();
 
 		// if whole path is found -> break out of loop
-		if (*current == end) break;
+		if (targets.contains(current)) break;
 
-		for (auto& edge : current->getEdges())
-		{
-			const float neighbourPathWeight = pathData[current].pathWeight + edge->weight;
-			const bool neighbourUnknown = pathData.find(edge->neighbour) == pathData.end();
-			const PathData nodeData{ current, neighbourPathWeight };
-
-			// discover new neighbours of current node
-			if (neighbourUnknown)
-			{
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				discovered.push(edge->neighbour);
-				searchLog.push_back({ edge->neighbour, NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-
-			// if pathWeight of neighbour is worse than current path -> replace pathData
-			else if (pathData[edge->neighbour].pathWeight > neighbourPathWeight)
-			{
-				pathData.insert_or_assign(edge->neighbour, nodeData);
-				const bool neighbourExplored = explored.find(edge->neighbour) != explored.end();
-				searchLog.push_back({ edge->neighbour, neighbourExplored ? NodeState::PROCESSED : NodeState::DISCOVERED, pathData[edge->neighbour] });
-			}
-		}
+		expand(graph, discovered, workspace, current, record);
 
 		// allowing breakpoint (not part of the algorithm)
 		runtime += high_resolution_clock().now() - startTime;
 		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
 		startTime = high_resolution_clock().now();
 
-		explored.insert(current);
-		searchLog.push_back({ current, NodeState::PROCESSED, pathData[current] });
+		workspace[current].explored = true;
+		exploredCount++;
+		record(graph, workspace, current, NodeState::PROCESSED);
 	}
 
 	runtime += high_resolution_clock().now() - startTime;
 
 	// no path found
-	if (*current != end)
+	if (current == INVALID_INDEX || !targets.contains(current))
 	{
-		searchResult = make_shared<SearchResult>(explored.size(), runtime);
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
 		co_return;
 	}
 
-	list<const Node*> path;
-	while (current != nullptr)
+	searchResult = make_shared<SearchResult>(buildResult(graph, workspace, current, exploredCount + 1, runtime));
+
+}
+
+template<typename GraphType, typename Targets, typename Queue>
+SearchResult Dijkstra::runIndexed(const GraphType& graph, const uint32_t start, const Targets& targets, Queue& discovered, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+
+	workspace.reset(graph.getIndexCount());
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	discovered.push(start, 0);
+
+	while (!discovered.empty())
+	{
+		current = discovered.pop();
+		if (targets.contains(current)) break;
+
+		expand(graph, discovered, workspace, current, NullRecorder {});
+		workspace[current].explored = true;
+		exploredCount++;
+	}
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (current == INVALID_INDEX || !targets.contains(current)) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, workspace, current, exploredCount + 1, runtime);
+}
+
+template<typename GraphType, typename Queue>
+void Dijkstra::runFieldIndexed(const GraphType& graph, const uint32_t start, Queue& discovered, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits) const
+{
+	field.clear();
+	workspace.reset(graph.getIndexCount());
+
+	workspace.discover(start, INVALID_INDEX, 0);
+	discovered.push(start, 0);
+
+	// nodes leave the heap in order of their path weight, so the first one beyond the radius ends the search
+	while (!discovered.empty() && field.size() < limits.maxNodes && discovered.topKey() <= limits.radius)
 	{
-		path.push_front(current);
-		current = pathData[current].previousNode;
+		const uint32_t current = discovered.pop();
+		field.push_back({ current, workspace[current].pathWeight, workspace[current].previous });
+
+		expand(graph, discovered, workspace, current, NullRecorder {});
+		workspace[current].explored = true;
 	}
+}
+
+Coroutine Dijkstra::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace, incrementalSearch); });
+}
+
+Coroutine Dijkstra::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace, incrementalSearch); });
+}
+
+SearchResult Dijkstra::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace); });
+}
+
+SearchResult Dijkstra::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start.getIndex(), SingleTarget { end.getIndex() }, discovered, workspace); });
+}
+
+SearchResult Dijkstra::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start, SingleTarget { end }, discovered, workspace); });
+}
 
-	searchResult = make_shared<SearchResult>(true, pathData[&end].pathWeight, move(path), explored.size() + 1, runtime);
+Coroutine Dijkstra::search(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, start.getIndex(), targets, discovered, workspace, incrementalSearch); });
+}
 
+Coroutine Dijkstra::search(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return searchIndexed(graph, start.getIndex(), targets, discovered, workspace, incrementalSearch); });
 }
+
+SearchResult Dijkstra::runSync(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start.getIndex(), targets, discovered, workspace); });
+}
+
+SearchResult Dijkstra::runSync(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start.getIndex(), targets, discovered, workspace); });
+}
+
+SearchResult Dijkstra::runSync(const ImplicitGridGraph& graph, const uint32_t start, const TargetSet& targets, SearchWorkspace& workspace) const
+{
+	return runWithQueue(graph, workspace, [&](auto& discovered) { return runIndexed(graph, start, targets, discovered, workspace); });
+}
+
+void Dijkstra::runField(const Graph& graph, const Node& start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits) const
+{
+	runWithQueue(graph, workspace, [&](auto& discovered) { runFieldIndexed(graph, start.getIndex(), discovered, workspace, field, limits); });
+}
+
+void Dijkstra::runField(const CompactGraph& graph, const Node& start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits) const
+{
+	runWithQueue(graph, workspace, [&](auto& discovered) { runFieldIndexed(graph, start.getIndex(), discovered, workspace, field, limits); });
+}
+
+void Dijkstra::runField(const ImplicitGridGraph& graph, const uint32_t start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits) const
+{
+	runWithQueue(graph, workspace, [&](auto& discovered) { runFieldIndexed(graph, start, discovered, workspace, field, limits); });
+}
\ No newline at end of file
@@ -1,12 +1,53 @@
 #pragma once
+#include "DistanceField.h"
 #include "Pathfinder.h"
+#include "QueuePolicy.h"
+#include "TargetSet.h"
 
 namespace Pathfinding
 {
     class Dijkstra : public Pathfinder
     {
+        private:
+
+        template<typename GraphType, typename Queue, typename Recorder>
+        void expand(const GraphType& graph, Queue& discovered, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const;
+
+        // resets the queue chosen for the graph and hands it to run
+        template<typename GraphType, typename Run>
+        auto runWithQueue(const GraphType& graph, SearchWorkspace& workspace, const Run& run) const;
+
+        // the targets are taken by value, they have to live as long as the coroutine frame
+        template<typename GraphType, typename Targets, typename Queue>
+        Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const Targets targets, Queue& discovered, SearchWorkspace& workspace, bool& incrementalSearch);
+
+        template<typename GraphType, typename Targets, typename Queue>
+        SearchResult runIndexed(const GraphType& graph, const uint32_t start, const Targets& targets, Queue& discovered, SearchWorkspace& workspace) const;
+
+        template<typename GraphType, typename Queue>
+        void runFieldIndexed(const GraphType& graph, const uint32_t start, Queue& discovered, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits) const;
+
         public:
 
-        Coroutine search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch) override;
+        QueuePolicy queuePolicy = QueuePolicy::Automatic;
+
+        Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+        Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+        SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+        SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+        SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+
+        // path to the cheapest reachable node of the target set
+        Coroutine search(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch);
+        Coroutine search(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace, bool& incrementalSearch);
+        SearchResult runSync(const Graph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const;
+        SearchResult runSync(const CompactGraph& graph, const Node& start, const TargetSet& targets, SearchWorkspace& workspace) const;
+        SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const TargetSet& targets, SearchWorkspace& workspace) const;
+
+        // one-to-all search from start, field is refilled with the settled nodes in order of their path weight
+        // the settled slots stay readable in the workspace, and neither the field nor the workspace allocates once both have grown to the graph
+        void runField(const Graph& graph, const Node& start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits = {}) const;
+        void runField(const CompactGraph& graph, const Node& start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits = {}) const;
+        void runField(const ImplicitGridGraph& graph, const uint32_t start, SearchWorkspace& workspace, std::vector<SettledNode>& field, const FieldLimits& limits = {}) const;
     };
 }
\ No newline at end of file
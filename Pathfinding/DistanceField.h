@@ -0,0 +1,56 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "Node.h"
+
+namespace Pathfinding
+{
+	// result of a one-to-all search, the shortest path tree of the source stored as distance and predecessor per index
+	struct DistanceField
+	{
+		uint32_t source = INVALID_INDEX;
+		std::vector<float> distances;
+		std::vector<uint32_t> previous;
+		std::chrono::nanoseconds runtime = std::chrono::nanoseconds::zero();
+
+		bool isReached(const uint32_t index) const { return distances[index] != std::numeric_limits<float>::infinity(); }
+
+		// indices from the source to target, empty if target was not reached
+		std::vector<uint32_t> getIndexPath(const uint32_t target) const
+		{
+			std::vector<uint32_t> indexPath;
+			if (!isReached(target)) return indexPath;
+
+			for (uint32_t current = target; current != INVALID_INDEX; current = previous[current]) indexPath.push_back(current);
+			std::reverse(indexPath.begin(), indexPath.end());
+			return indexPath;
+		}
+	};
+
+	// dense matrix of the path weights from every source to every target, rows are sources and unreachable pairs are infinite
+	struct DistanceTable
+	{
+		size_t sourceCount = 0;
+		size_t targetCount = 0;
+		std::vector<float> distances;
+		std::chrono::nanoseconds runtime = std::chrono::nanoseconds::zero();
+
+		float at(const size_t source, const size_t target) const { return distances[source * targetCount + target]; }
+	};
+
+	// one node settled by a bounded one-to-all search, previous is the index of the node its shortest path came from
+	struct SettledNode
+	{
+		uint32_t index;
+		float pathWeight;
+		uint32_t previous;
+	};
+
+	// a bounded one-to-all search stops before settling a node beyond the radius or more than maxNodes nodes
+	struct FieldLimits
+	{
+		float radius = std::numeric_limits<float>::infinity();
+		size_t maxNodes = std::numeric_limits<size_t>::max();
+	};
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 using namespace Pathfinding;
 
-Environment::Environment(SDL_Window* window)
+Environment::Environment(SDL_Window* window, std::shared_ptr<Graph> graph) : graph(move(graph))
 {
     renderData.window = window;
     renderData.renderer = SDL_CreateRenderer(renderData.window, -1, SDL_RENDERER_ACCELERATED);
@@ -74,7 +74,7 @@ void Environment::drawSearchData(const Node& node, const PathData& pathData) con
 void Environment::searchInitialize(std::unique_ptr<Pathfinder>&& pathfinder, const Node& start, const Node& end)
 {
     searchData.pathfinder = move(pathfinder);
-    if (searchData.pathfinder) searchData.searchCoroutine = searchData.pathfinder->search(*graph, start, end, searchData.incrementalSearch);
+    if (searchData.pathfinder) searchData.searchCoroutine = searchData.pathfinder->search(*graph, start, end, searchData.workspace, searchData.incrementalSearch);
 
     resetRenderState();
     renderEnvironment();
@@ -97,8 +97,8 @@ bool Environment::searchRun()
         {
             SDL_Color nodeColor = getColorOf(logItem.state);
             drawNode(*logItem.node, nodeColor);
-            drawSearchData(*logItem.node, logItem.pathData);
-            nodeStates[logItem.node] = { nodeColor, logItem.pathData };
+            drawSearchData(*logItem.node, *logItem.pathData);
+            nodeStates[logItem.node] = { nodeColor, *logItem.pathData };
         }
         renderEnvironment();
     }
@@ -28,6 +28,7 @@ namespace Pathfinding
 		{
 			bool incrementalSearch = false;
 			std::unique_ptr<Pathfinder> pathfinder;
+			SearchWorkspace workspace;
 			Coroutine searchCoroutine;
 		};
 
@@ -43,7 +44,7 @@ namespace Pathfinding
 		std::unordered_map<const Node*, NodeData> nodeStates;
 
 
-		Environment(SDL_Window* window);
+		Environment(SDL_Window* window, std::shared_ptr<Graph> graph);
 
 		void applyNodeStates() const;
 		void drawSearchData(const Node& node, const PathData& pathData) const;
@@ -1,4 +1,5 @@
 #include "Graph.h"
+#include <stdexcept>
 
 using namespace Pathfinding;
 
@@ -6,38 +7,133 @@ Graph::Graph(std::vector<std::unique_ptr<Node>>&& nodes)
 {
 	for (auto& node : nodes)
 	{
-		this->nodes.insert({node->getName(), move(node)});
+		addNode(move(node));
 	}
 	nodes.clear();
 }
 
 void Graph::addNode(std::unique_ptr<Node>&& node)
 {
-	// automatically checks if element already contained, adds element if not
-	this->nodes.insert({node->getName(), move(node)});
+	// drop node if its name is already contained
+	if (!node->name.empty() && !this->nameIndex.insert({ node->name, (uint32_t)this->nodeTable.size() }).second) return;
+
+	// hand out next dense index
+	node->index = (uint32_t)this->nodeTable.size();
+	node->graph = this;
+	this->nodeTable.push_back(move(node));
+}
+
+uint32_t Graph::addNodes(const size_t count)
+{
+	// allocate a block of unnamed nodes at once
+	const uint32_t firstIndex = (uint32_t)this->nodeTable.size();
+	this->nodeTable.reserve(this->nodeTable.size() + count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		auto node = std::make_unique<Node>();
+		node->index = (uint32_t)this->nodeTable.size();
+		node->graph = this;
+		this->nodeTable.push_back(move(node));
+	}
+
+	return firstIndex;
 }
 
 bool Graph::removeNode(const std::string name)
 {
 	// return false if element not contained
-	auto iter = this->nodes.find(name);
-	if (iter == this->nodes.end()) return false;
+	const uint32_t index = findIndex(name);
+	if (index == INVALID_INDEX) return false;
 
-	// else delete element
-	this->nodes.erase(iter);
+	// else delete element, its index stays reserved
+	this->nameIndex.erase(name);
+	this->nodeTable[index].reset();
 	return true;
 }
 
 bool Graph::contains(const std::string name) const
 {
-	auto iter = this->nodes.find(name);
-	return iter != this->nodes.end();
+	return findIndex(name) != INVALID_INDEX;
 }
 
 bool Graph::tryGetNode(const std::string name, const std::unique_ptr<Node>*& out) const
 {
-	if (!contains(name)) return false;
+	const uint32_t index = findIndex(name);
+	if (index == INVALID_INDEX) return false;
 
-	out = &getNode(name);
+	out = &this->nodeTable[index];
 	return true;
+}
+
+void Graph::setNaming(std::function<std::string(const uint32_t index)> generateName, std::function<uint32_t(const std::string& name)> parseName)
+{
+	this->generateName = move(generateName);
+	this->parseName = move(parseName);
+}
+
+uint64_t Graph::updateEdges(const std::vector<EdgeUpdate>& updates)
+{
+	ChangeSet changeSet { this->version + 1, {} };
+	for (const EdgeUpdate& update : updates)
+	{
+		// nodes are looked up by their dense index, removed nodes have no edges left to change
+		if (update.from >= this->nodeTable.size() || update.to >= this->nodeTable.size()) continue;
+		Node* from = this->nodeTable[update.from].get();
+		const Node* to = this->nodeTable[update.to].get();
+		if (!from || !to) continue;
+
+		Edge* edge = from->findEdge(*to);
+		if (!edge || edge->weight == update.weight) continue;
+
+		changeSet.edges.push_back({ update.from, update.to, edge->weight, update.weight });
+		edge->weight = update.weight;
+	}
+	if (changeSet.edges.empty()) return this->version;
+
+	this->version = changeSet.version;
+	this->changeLog.push_back(std::move(changeSet));
+	while (this->changeLog.size() > this->changeLogCapacity) this->changeLog.pop_front();
+	return this->version;
+}
+
+bool Graph::getChangesSince(const uint64_t version, std::vector<EdgeChange>& changes) const
+{
+	if (version == this->version) return true;
+
+	// the log holds consecutive versions, so the batch right after the given version is either the first one or gone
+	if (this->changeLog.empty() || this->changeLog.front().version > version + 1) return false;
+
+	for (const ChangeSet& changeSet : this->changeLog)
+	{
+		if (changeSet.version > version) changes.insert(changes.end(), changeSet.edges.begin(), changeSet.edges.end());
+	}
+	return true;
+}
+
+void Graph::setChangeLogCapacity(const size_t capacity)
+{
+	this->changeLogCapacity = capacity;
+	while (this->changeLog.size() > this->changeLogCapacity) this->changeLog.pop_front();
+}
+
+const std::unique_ptr<Node>& Graph::getNode(const std::string name) const
+{
+	const uint32_t index = findIndex(name);
+	if (index == INVALID_INDEX) throw std::out_of_range("Graph does not contain a node named " + name + ".");
+
+	return this->nodeTable[index];
+}
+
+uint32_t Graph::findIndex(const std::string& name) const
+{
+	auto iter = this->nameIndex.find(name);
+	if (iter != this->nameIndex.end()) return iter->second;
+
+	// the naming scheme only covers nodes without an explicit name
+	if (!this->parseName) return INVALID_INDEX;
+	const uint32_t index = this->parseName(name);
+	if (index >= this->nodeTable.size() || !this->nodeTable[index] || !this->nodeTable[index]->name.empty()) return INVALID_INDEX;
+
+	return index;
 }
\ No newline at end of file
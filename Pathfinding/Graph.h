@@ -1,26 +1,109 @@
 #pragma once
+#include <deque>
+#include <functional>
 #include <unordered_map>
 #include "Node.h"
 
 namespace Pathfinding
 {
+	// new weight of the edge from -> to, both given by their node index
+	struct EdgeUpdate
+	{
+		uint32_t from;
+		uint32_t to;
+		float weight;
+	};
+
+	struct EdgeChange
+	{
+		uint32_t from;
+		uint32_t to;
+		float previousWeight;
+		float weight;
+	};
+
+	// every batch that changed at least one weight raises the version of the graph by one
+	struct ChangeSet
+	{
+		uint64_t version;
+		std::vector<EdgeChange> edges;
+	};
+
 	class Graph
 	{
+		friend class Node;
+
 		private:
 
-		std::unordered_map<std::string, std::unique_ptr<Node>> nodes;
+		std::vector<std::unique_ptr<Node>> nodeTable;
+		std::unordered_map<std::string, uint32_t> nameIndex;
+
+		std::function<std::string(const uint32_t index)> generateName;
+		std::function<uint32_t(const std::string& name)> parseName;
+
+		uint64_t version = 0;
+		std::deque<ChangeSet> changeLog;
+		size_t changeLogCapacity = 64;
+
+		uint32_t findIndex(const std::string& name) const;
 
 		public:
 
+		class EdgeRange
+		{
+			private:
+
+			const std::vector<Edge>& edges;
+
+			public:
+
+			struct Iterator
+			{
+				std::vector<Edge>::const_iterator edge;
+
+				IndexedEdge operator*() const { return { edge->neighbour->getIndex(), edge->weight }; }
+				Iterator& operator++() { edge++; return *this; }
+				bool operator!=(const Iterator& other) const { return edge != other.edge; }
+			};
+
+			EdgeRange(const std::vector<Edge>& edges) : edges(edges) {}
+
+			Iterator begin() const { return { edges.begin() }; }
+			Iterator end() const { return { edges.end() }; }
+			size_t size() const { return edges.size(); }
+		};
+
 		Graph(std::vector<std::unique_ptr<Node>> && = {});
 		void addNode(std::unique_ptr<Node>&& node);
+		uint32_t addNodes(const size_t count);
 		bool removeNode(const std::string name);
 		bool contains(const std::string name) const;
 		bool tryGetNode(const std::string name, const std::unique_ptr<Node>*& out) const;
 
+		// names of unnamed nodes are only generated when asked for, parseName has to be the inverse of generateName
+		void setNaming(std::function<std::string(const uint32_t index)> generateName, std::function<uint32_t(const std::string& name)> parseName);
+
 		~Graph() { clear(); }
-		void clear() { nodes.clear(); }
-		const std::unique_ptr<Node>& getNode(const std::string name) const { return nodes.at(name); }
-		const std::unordered_map<std::string, std::unique_ptr<Node>>& getNodes() const { return nodes; }
+		void clear() { nameIndex.clear(); nodeTable.clear(); }
+		void reserve(const size_t count) { nodeTable.reserve(count); }
+		const std::unique_ptr<Node>& getNode(const std::string name) const;
+		const std::vector<std::unique_ptr<Node>>& getNodes() const { return nodeTable; }
+
+		// indices are handed out in insertion order and never reused, removed nodes leave a nullptr behind
+		Node* nodeAt(const uint32_t index) const { return nodeTable[index].get(); }
+		size_t getIndexCount() const { return nodeTable.size(); }
+		EdgeRange getEdges(const uint32_t index) const { return EdgeRange(nodeTable[index]->getEdges()); }
+
+		// applies all weights of the batch and returns the new version, updates of missing edges are skipped
+		// only changes made through here are tracked, edges edited on a Node directly are not
+		uint64_t updateEdges(const std::vector<EdgeUpdate>& updates);
+		uint64_t getVersion() const { return version; }
+
+		// appends the changes of all batches after the given version in order
+		// returns false if some of them were already dropped from the change log, the consumer then has to rebuild from the graph
+		bool getChangesSince(const uint64_t version, std::vector<EdgeChange>& changes) const;
+
+		// number of batches kept for consumers that catch up later
+		void setChangeLogCapacity(const size_t capacity);
 	};
 }
\ No newline at end of file
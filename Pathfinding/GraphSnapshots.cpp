@@ -0,0 +1,26 @@
+#include "GraphSnapshots.h"
+
+using namespace Pathfinding;
+
+GraphSnapshots::GraphSnapshots(const Graph& graph, const EdgeDirection direction)
+{
+	// every version carries its reverse, so searches walking edges backwards see the weights of the pinned version as well
+	const std::shared_ptr<CompactGraph> first = std::make_shared<CompactGraph>(graph, direction);
+	first->buildReverse();
+	current.store(first);
+}
+
+uint64_t GraphSnapshots::update(const std::vector<EdgeUpdate>& updates)
+{
+	// only writers take this lock, so two of them can not build on the same version and lose the changes of one
+	std::lock_guard<std::mutex> lock(writerMutex);
+
+	const std::shared_ptr<const CompactGraph> previous = current.load(std::memory_order_relaxed);
+	std::shared_ptr<const CompactGraph> next = previous->createVersion(updates);
+	if (!next) return previous->getSnapshotVersion();
+
+	// readers still holding the previous version keep it alive, it is freed once the last of them lets go
+	const uint64_t version = next->getSnapshotVersion();
+	current.store(std::move(next), std::memory_order_release);
+	return version;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include "CompactGraph.h"
+
+namespace Pathfinding
+{
+	// publishes immutable versions of a graph, so weights can change while searches are running on it
+	// writers copy the weight blocks their updates touch into a new version and swap it in, readers pin a version without taking the writer lock
+	// the atomic shared_ptr is not lock-free, readers may briefly wait for the swap itself but never for a version being built
+	// the source graph is only read while the first version is built, it has to outlive the snapshots and must not lose nodes
+	class GraphSnapshots
+	{
+		private:
+
+		std::atomic<std::shared_ptr<const CompactGraph>> current;
+		std::mutex writerMutex;
+
+		public:
+
+		GraphSnapshots(const Graph& graph, const EdgeDirection direction = EdgeDirection::Outgoing);
+
+		// the pinned version stays alive and unchanged for as long as the caller holds it, later updates only affect later pins
+		std::shared_ptr<const CompactGraph> pin() const { return current.load(std::memory_order_acquire); }
+		uint64_t getVersion() const { return pin()->getSnapshotVersion(); }
+
+		// builds the next version from the current one and publishes it, writers are serialised among themselves
+		// versions count from 0 for the graph the snapshots were built from and are unrelated to the graph's own version
+		// updates of missing edges are skipped, if no weight changed nothing is published and the current version is returned
+		uint64_t update(const std::vector<EdgeUpdate>& updates);
+	};
+}
\ No newline at end of file
@@ -1,48 +1,18 @@
 #include "Grid.h"
 #include "AStar.h"
-#include <PerlinNoise/PerlinNoise.hpp>
+#include "BidirectionalAStar.h"
+#include "JumpPointSearch.h"
+#include "HierarchicalAStar.h"
+#include "ContractionHierarchySearch.h"
 
 using namespace Pathfinding;
 
-constexpr int HEIGHTMAP_STEPS = 8;
 const std::string FONT_NAME = "C:/Windows/Fonts/ariblk.ttf";
 
-Grid::Grid(const int width, const int height, SDL_Window* window) : Environment(window)
+Grid::Grid(std::shared_ptr<const GridGraph> gridGraph, SDL_Window* window) : Environment(window, gridGraph->graph), gridGraph(gridGraph)
 {
-	using namespace std;
-
-    if (width <= 0 || height <= 0) throw exception("Width and height of grid have to be greater than 0.");
-    gridData.gridWidth = width;
-    gridData.gridHeight = height;
-
-    gridData.heightMap.resize((size_t)width * height);
-	graph = make_shared<Graph>();
-
-    constexpr double noiseScale = 0.4;
-    const siv::PerlinNoise::seed_type seed = (unsigned int)time(NULL);
-
-    const siv::PerlinNoise perlin { seed };
-    auto edgeWeight = [&](int x1, int y1, int x2, int y2)
-    {
-        int gradient = gridData.heightMap[(size_t)x2 * gridData.gridWidth + y2] - gridData.heightMap[(size_t)x1 * gridData.gridWidth + y1];
-        if (gradient < 0) gradient /= 2;
-        return (float)(gradient + HEIGHTMAP_STEPS);
-    };
-
-    for (int x = 0; x < gridData.gridWidth; x++)
-    {
-        for (int y = 0; y < gridData.gridHeight; y++)
-        {
-            auto node = Node::create(generateNodeName(x, y));
-            gridData.heightMap[(size_t)x * gridData.gridWidth + y] = (int)(perlin.noise2D_01(x * noiseScale, y * noiseScale) * HEIGHTMAP_STEPS);
-
-            const unique_ptr<Node>* neighbour;
-            if (x > 0 && graph->tryGetNode(generateNodeName(x - 1, y), neighbour)) { node->addEdge(*neighbour->get(), edgeWeight(x, y, x - 1, y)); (*neighbour)->addEdge(*node.get(), edgeWeight(x - 1, y, x, y)); }
-            if (y > 0 && graph->tryGetNode(generateNodeName(x, y - 1), neighbour)) { node->addEdge(*neighbour->get(), edgeWeight(x, y, x, y - 1)); (*neighbour)->addEdge(*node.get(), edgeWeight(x, y - 1, x, y)); }
-
-            graph->addNode(move(node));
-        }
-    }
+    gridData.gridWidth = gridGraph->width;
+    gridData.gridHeight = gridGraph->height;
 
     refreshWindow();
 }
@@ -156,7 +126,7 @@ void Grid::drawEdgeWeights() const
             const SDL_Rect outline = { xPos, yPos, gridData.nodeWidth, gridData.nodeHeight };
             const SDL_Rect center = { xPos + outlineWidth, yPos + outlineHeight, gridData.nodeWidth - (outlineWidth * 2), gridData.nodeHeight - (outlineHeight * 2) };
 
-            const Uint8 greyValue = 250 - ((200 / HEIGHTMAP_STEPS) * gridData.heightMap[(size_t)x * gridData.gridWidth + y]);
+            const Uint8 greyValue = 250 - ((200 / HEIGHTMAP_STEPS) * gridGraph->getHeight(x, y));
             color = { greyValue, greyValue, greyValue, 255 };
             SDL_SetRenderDrawColor(renderData.renderer, color.r, color.g, color.b, color.a);
             SDL_RenderFillRect(renderData.renderer, &outline);
@@ -297,7 +267,7 @@ void Grid::drawCoordinates() const
     {
         for (int y = 0; y < gridData.gridHeight; y++)
         {
-            SDL_Surface* textSurface = TTF_RenderUTF8_Blended(font, Grid::generateNodeName(x, y).data(), GridColor::TEXT);
+            SDL_Surface* textSurface = TTF_RenderUTF8_Blended(font, GridGraphBuilder::generateNodeName(x, y).data(), GridColor::TEXT);
             SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderData.renderer, textSurface);
 
             auto [xPos, yPos] = getScreenCoordinates(x, y);
@@ -320,31 +290,34 @@ void Grid::searchInitialize(std::unique_ptr<Pathfinder>&& pathfinder, const Node
     Environment::searchInitialize(move(pathfinder), start, end);
 
     // set heuristic in case of AStar
-    AStar* pathfinderAsAStar = dynamic_cast<AStar*>(searchData.pathfinder.get());
-    if (pathfinderAsAStar) pathfinderAsAStar->getHeuristic = [](const Graph& graph, const Node& current, const Node& target)
+    const auto heuristic = [gridGraph = gridGraph](const Graph& graph, const Node& current, const Node& target)
     {
-        // Manhattan Distance
-        const auto [currentX, currentY] = Grid::getGridCoordinates(current);
-        const auto [targetX, targetY] = Grid::getGridCoordinates(target);
+        // Manhattan Distance, coordinates are derived from the node index
+        const int currentX = gridGraph->getX(current.getIndex()), currentY = gridGraph->getY(current.getIndex());
+        const int targetX = gridGraph->getX(target.getIndex()), targetY = gridGraph->getY(target.getIndex());
         return (float)(abs(targetX - currentX) + abs(targetY - currentY));
     };
-}
 
-const SDL_Point Grid::getGridCoordinates(const Node& node)
-{
-    using namespace std;
+    AStar* pathfinderAsAStar = dynamic_cast<AStar*>(searchData.pathfinder.get());
+    if (pathfinderAsAStar) pathfinderAsAStar->getHeuristic = heuristic;
 
-    int x, y;
-    const string name = node.getName();
-    const size_t midPoint = name.find(",");
+    BidirectionalAStar* pathfinderAsBidirectionalAStar = dynamic_cast<BidirectionalAStar*>(searchData.pathfinder.get());
+    if (pathfinderAsBidirectionalAStar) pathfinderAsBidirectionalAStar->getHeuristic = heuristic;
 
-    const string tmp1 = name.substr(0, midPoint);
-    from_chars(tmp1.data(), tmp1.data() + tmp1.size(), x);
+    // set grid layout in case of JumpPointSearch or HierarchicalAStar
+    JumpPointSearch* pathfinderAsJumpPointSearch = dynamic_cast<JumpPointSearch*>(searchData.pathfinder.get());
+    if (pathfinderAsJumpPointSearch) pathfinderAsJumpPointSearch->setLayout(gridGraph->layout);
+    HierarchicalAStar* pathfinderAsHierarchicalAStar = dynamic_cast<HierarchicalAStar*>(searchData.pathfinder.get());
+    if (pathfinderAsHierarchicalAStar) pathfinderAsHierarchicalAStar->setLayout(gridGraph->layout);
 
-    const string tmp2 = name.substr(midPoint + 2);
-    from_chars(tmp2.data(), tmp2.data() + tmp2.size(), y);
-    
-    return SDL_Point{ x, y };
+    // contract the grid graph in case of ContractionHierarchySearch
+    ContractionHierarchySearch* pathfinderAsContractionHierarchySearch = dynamic_cast<ContractionHierarchySearch*>(searchData.pathfinder.get());
+    if (pathfinderAsContractionHierarchySearch) pathfinderAsContractionHierarchySearch->setHierarchy(std::make_shared<ContractionHierarchy>(*gridGraph->graph));
+}
+
+const SDL_Point Grid::getGridCoordinates(const Node& node) const
+{
+    return SDL_Point{ gridGraph->getX(node.getIndex()), gridGraph->getY(node.getIndex()) };
 }
 
 const SDL_Point Grid::getScreenCoordinates(const Node& node) const
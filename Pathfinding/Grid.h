@@ -1,6 +1,6 @@
 #pragma once
-#include <format>
 #include "Environment.h"
+#include "GridGraphBuilder.h"
 
 namespace Pathfinding
 {
@@ -26,11 +26,10 @@ namespace Pathfinding
 			int marginWidth, marginHeight;
 			int borderWidth, borderHeight;
 			int nodeWidth, nodeHeight;
-
-			std::vector<int> heightMap;
 		};
 
 		GridData gridData;
+		std::shared_ptr<const GridGraph> gridGraph;
 
 		void resetRenderState() override;
 		void drawGraph() const override;
@@ -43,16 +42,14 @@ namespace Pathfinding
 
 		public:
 
-		Grid(const int width, const int height, SDL_Window* window);
+		Grid(std::shared_ptr<const GridGraph> gridGraph, SDL_Window* window);
 
 		void refreshWindow() override;
 		void searchInitialize(std::unique_ptr<Pathfinder>&& pathfinder, const Node& start, const Node& end) override;
 		const SDL_Color getColorOf(NodeState nodeState) const override;
 
-		static const SDL_Point getGridCoordinates(const Node& node);
+		const SDL_Point getGridCoordinates(const Node& node) const;
 		const SDL_Point getScreenCoordinates(const Node& node) const;
 		const SDL_Point getScreenCoordinates(const int gridX, const int gridY) const;
-
-		static std::string generateNodeName(const int x, const int y) { return std::format("{}, {}", x, y); }
 	};	
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "GridGraphBuilder.h"
+#include <charconv>
+#include <PerlinNoise/PerlinNoise.hpp>
+
+using namespace Pathfinding;
+
+GridGraphBuilder::GridGraphBuilder(const int width, const int height, const unsigned int seed, const GridConnectivity connectivity)
+	: width(width), height(height), seed(seed), connectivity(connectivity)
+{
+	if (width <= 0 || height <= 0) throw std::exception("Width and height of grid have to be greater than 0.");
+}
+
+std::vector<int> GridGraphBuilder::generateHeightMap() const
+{
+	constexpr double noiseScale = 0.4;
+	const siv::PerlinNoise perlin { seed };
+
+	std::vector<int> heightMap((size_t)width * height);
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			heightMap[(size_t)x * height + y] = (int)(perlin.noise2D_01(x * noiseScale, y * noiseScale) * HEIGHTMAP_STEPS);
+		}
+	}
+
+	return heightMap;
+}
+
+std::shared_ptr<GridGraph> GridGraphBuilder::build() const
+{
+	using namespace std;
+
+	auto gridGraph = make_shared<GridGraph>();
+	gridGraph->width = width;
+	gridGraph->height = height;
+	gridGraph->layout = buildImplicit();
+	gridGraph->graph = make_shared<Graph>();
+
+	// the implicit grid defines neighbours and weights, the graph only materialises them
+	const ImplicitGridGraph& grid = *gridGraph->layout;
+
+	// allocate all nodes up front, names are only generated if someone asks for them
+	Graph& graph = *gridGraph->graph;
+	const int gridHeight = height, gridWidth = width;
+	graph.setNaming(
+		[gridHeight](const uint32_t index) { return generateNodeName(index / gridHeight, index % gridHeight); },
+		[gridWidth, gridHeight](const string& name)
+		{
+			int x, y;
+			if (!parseNodeName(name, x, y) || x < 0 || y < 0 || x >= gridWidth || y >= gridHeight) return INVALID_INDEX;
+			return (uint32_t)((size_t)x * gridHeight + y);
+		});
+	const uint32_t firstIndex = graph.addNodes(grid.getIndexCount());
+
+	// wire neighbours in one linear pass
+	for (uint32_t index = 0; index < grid.getIndexCount(); index++)
+	{
+		Node& node = *graph.nodeAt(firstIndex + index);
+		node.reserveEdges((size_t)connectivity);
+
+		for (const auto [neighbour, weight] : grid.getEdges(index))
+		{
+			node.addEdge(*graph.nodeAt(firstIndex + neighbour), weight);
+		}
+	}
+
+	return gridGraph;
+}
+
+std::shared_ptr<ImplicitGridGraph> GridGraphBuilder::buildImplicit() const
+{
+	return std::make_shared<ImplicitGridGraph>(width, height, connectivity, generateHeightMap());
+}
+
+bool GridGraphBuilder::parseNodeName(const std::string& name, int& x, int& y)
+{
+	const size_t midPoint = name.find(", ");
+	if (midPoint == std::string::npos) return false;
+
+	const char* end = name.data() + name.size();
+	const auto [xEnd, xError] = std::from_chars(name.data(), name.data() + midPoint, x);
+	const auto [yEnd, yError] = std::from_chars(name.data() + midPoint + 2, end, y);
+	return xError == std::errc() && yError == std::errc() && xEnd == name.data() + midPoint && yEnd == end;
+}
\ No newline at end of file
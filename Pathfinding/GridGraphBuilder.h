@@ -0,0 +1,43 @@
+#pragma once
+#include <format>
+#include "Graph.h"
+#include "ImplicitGridGraph.h"
+
+namespace Pathfinding
+{
+	// heightmap grid graph, cells are stored column by column so cell (x, y) lives at x * height + y
+	// the layout describes the same grid implicitly, its indices match the ones of the graph
+	struct GridGraph
+	{
+		int width, height;
+		std::shared_ptr<const ImplicitGridGraph> layout;
+		std::shared_ptr<Graph> graph;
+
+		int getHeight(const int x, const int y) const { return layout->getHeight(x, y); }
+		int getX(const uint32_t index) const { return (int)(index / height); }
+		int getY(const uint32_t index) const { return (int)(index % height); }
+	};
+
+	// generates the Perlin heightmap graph of a Grid without any rendering, so it can run in headless processes
+	class GridGraphBuilder
+	{
+		private:
+
+		const int width, height;
+		const unsigned int seed;
+		const GridConnectivity connectivity;
+
+		std::vector<int> generateHeightMap() const;
+
+		public:
+
+		GridGraphBuilder(const int width, const int height, const unsigned int seed, const GridConnectivity connectivity = GridConnectivity::FourNeighbours);
+		std::shared_ptr<GridGraph> build() const;
+
+		// same grid without any Node or Edge objects, only the heightmap is kept in memory
+		std::shared_ptr<ImplicitGridGraph> buildImplicit() const;
+
+		static std::string generateNodeName(const int x, const int y) { return std::format("{}, {}", x, y); }
+		static bool parseNodeName(const std::string& name, int& x, int& y);
+	};
+}
\ No newline at end of file
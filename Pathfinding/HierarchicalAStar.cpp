@@ -0,0 +1,482 @@
+#include "HierarchicalAStar.h"
+#include "AStar.h"
+
+using namespace Pathfinding;
+
+HierarchicalAStar::HierarchicalAStar(const int clusterSize, const int transitionsPerBorder) : clusterSize(clusterSize), transitionsPerBorder(transitionsPerBorder)
+{
+	if (clusterSize <= 0 || transitionsPerBorder <= 0) throw std::exception("HierarchicalAStar needs a positive cluster size and at least one transition per border.");
+}
+
+HierarchicalAStar::Cluster HierarchicalAStar::getCluster(const uint32_t cluster) const
+{
+	const int x = (int)(cluster / clusterCountY) * clusterSize, y = (int)(cluster % clusterCountY) * clusterSize;
+	return { x, y, std::min(clusterSize, layout->getGridWidth() - x), std::min(clusterSize, layout->getGridHeight() - y) };
+}
+
+uint32_t HierarchicalAStar::getClusterIndex(const ImplicitGridGraph& grid, const uint32_t cell) const
+{
+	return (uint32_t)((grid.getX(cell) / clusterSize) * clusterCountY + grid.getY(cell) / clusterSize);
+}
+
+void HierarchicalAStar::setAbstractEdge(Node& from, const Node& to, const float weight)
+{
+	// addEdge keeps the weight of an existing edge
+	from.addEdge(to, weight);
+	from.setEdgeWeight(to, weight);
+}
+
+size_t HierarchicalAStar::searchCluster(const ImplicitGridGraph& grid, const uint32_t cluster, const uint32_t source, const bool incoming, SearchWorkspace& workspace, const uint32_t target) const
+{
+	const Cluster bounds = getCluster(cluster);
+	size_t exploredCount = 0;
+
+	workspace.reset(bounds.getCellCount());
+	auto& discovered = workspace.pathWeightHeap;
+
+	const uint32_t localSource = bounds.getLocalIndex(grid.getX(source), grid.getY(source));
+	workspace.discover(localSource, INVALID_INDEX, 0);
+	discovered.push(localSource, 0);
+
+	while (!discovered.empty())
+	{
+		const uint32_t current = discovered.pop();
+		workspace[current].explored = true;
+		exploredCount++;
+
+		const uint32_t cell = grid.getIndex(bounds.x + current / bounds.height, bounds.y + current % bounds.height);
+		if (cell == target) break;
+
+		for (const auto [neighbour, weight] : incoming ? grid.getIncomingEdges(cell) : grid.getEdges(cell))
+		{
+			const int neighbourX = grid.getX(neighbour), neighbourY = grid.getY(neighbour);
+			if (!bounds.contains(neighbourX, neighbourY)) continue;
+
+			const uint32_t localNeighbour = bounds.getLocalIndex(neighbourX, neighbourY);
+			const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+			if (!workspace.isKnown(localNeighbour))
+			{
+				workspace.discover(localNeighbour, current, neighbourPathWeight);
+				discovered.push(localNeighbour, neighbourPathWeight);
+			}
+			else if (!workspace[localNeighbour].explored && workspace[localNeighbour].pathWeight > neighbourPathWeight)
+			{
+				workspace[localNeighbour].previous = current;
+				workspace[localNeighbour].pathWeight = neighbourPathWeight;
+				discovered.decrease(localNeighbour, neighbourPathWeight);
+			}
+		}
+	}
+
+	return exploredCount;
+}
+
+void HierarchicalAStar::buildCluster(const ImplicitGridGraph& grid, const uint32_t cluster, SearchWorkspace& workspace)
+{
+	// every transition gets an edge to every other transition of its cluster, clusters have no obstacles so all of them are reachable
+	const Cluster bounds = getCluster(cluster);
+	for (const uint32_t transition : clusterTransitions[cluster])
+	{
+		searchCluster(grid, cluster, transitionCells[transition], false, workspace);
+
+		for (const uint32_t other : clusterTransitions[cluster])
+		{
+			if (other == transition) continue;
+
+			const uint32_t cell = transitionCells[other];
+			const float pathWeight = workspace[bounds.getLocalIndex(grid.getX(cell), grid.getY(cell))].pathWeight;
+			setAbstractEdge(*abstractGraph.nodeAt(transition), *abstractGraph.nodeAt(other), pathWeight);
+		}
+	}
+}
+
+void HierarchicalAStar::buildCrossing(const ImplicitGridGraph& grid, const std::pair<uint32_t, uint32_t>& crossing)
+{
+	const auto [first, second] = crossing;
+	const int firstHeight = grid.getHeight(grid.getX(transitionCells[first]), grid.getY(transitionCells[first]));
+	const int secondHeight = grid.getHeight(grid.getX(transitionCells[second]), grid.getY(transitionCells[second]));
+
+	setAbstractEdge(*abstractGraph.nodeAt(first), *abstractGraph.nodeAt(second), ImplicitGridGraph::getEdgeWeight(firstHeight, secondHeight));
+	setAbstractEdge(*abstractGraph.nodeAt(second), *abstractGraph.nodeAt(first), ImplicitGridGraph::getEdgeWeight(secondHeight, firstHeight));
+}
+
+uint32_t HierarchicalAStar::getCell(const uint32_t abstractIndex, const uint32_t start, const uint32_t end) const
+{
+	if (abstractIndex < transitionCells.size()) return transitionCells[abstractIndex];
+	return abstractIndex == transitionCells.size() ? start : end;
+}
+
+size_t HierarchicalAStar::connect(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, Connections& connections) const
+{
+	connections.startCluster = getClusterIndex(grid, start);
+	connections.endCluster = getClusterIndex(grid, end);
+
+	// cheapest paths from the start node to the transitions of its cluster
+	const Cluster startBounds = getCluster(connections.startCluster);
+	size_t exploredCount = searchCluster(grid, connections.startCluster, start, false, workspace);
+	for (const uint32_t transition : clusterTransitions[connections.startCluster])
+	{
+		const uint32_t cell = transitionCells[transition];
+		connections.startEdges.push_back({ transition, workspace[startBounds.getLocalIndex(grid.getX(cell), grid.getY(cell))].pathWeight });
+	}
+
+	// a path that never leaves the cluster may be cheaper than any path through its border
+	if (connections.startCluster == connections.endCluster)
+	{
+		connections.directWeight = workspace[startBounds.getLocalIndex(grid.getX(end), grid.getY(end))].pathWeight;
+	}
+
+	// cheapest paths from the transitions of the end cluster to the end node, searched along incoming edges
+	const Cluster endBounds = getCluster(connections.endCluster);
+	exploredCount += searchCluster(grid, connections.endCluster, end, true, workspace);
+	for (const uint32_t transition : clusterTransitions[connections.endCluster])
+	{
+		const uint32_t cell = transitionCells[transition];
+		connections.endEdges.push_back({ transition, workspace[endBounds.getLocalIndex(grid.getX(cell), grid.getY(cell))].pathWeight });
+	}
+
+	return exploredCount;
+}
+
+template<typename Recorder>
+void HierarchicalAStar::expand(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, const Connections& connections, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const
+{
+	const uint32_t startIndex = (uint32_t)transitionCells.size(), endIndex = startIndex + 1;
+
+	auto visit = [&](const uint32_t neighbour, const float weight)
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new abstract nodes
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight, grid.getDistanceEstimate(getCell(neighbour, start, end), end));
+			workspace.estimateHeap.push(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of abstract node is worse than current path -> replace pathData and move it up in the queue, explored nodes are reopened
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace[neighbour].explored = false;
+			workspace.estimateHeap.pushOrDecrease(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(workspace, neighbour, NodeState::DISCOVERED);
+		}
+	};
+
+	if (current == startIndex)
+	{
+		for (const auto& [transition, weight] : connections.startEdges) visit(transition, weight);
+		if (connections.directWeight < std::numeric_limits<float>::infinity()) visit(endIndex, connections.directWeight);
+		return;
+	}
+
+	for (const auto [neighbour, weight] : abstractGraph.getEdges(current)) visit(neighbour, weight);
+
+	if (getClusterIndex(grid, transitionCells[current]) != connections.endCluster) return;
+	for (const auto& [transition, weight] : connections.endEdges)
+	{
+		if (transition == current) visit(endIndex, weight);
+	}
+}
+
+std::vector<uint32_t> HierarchicalAStar::getWaypoints(const SearchWorkspace& workspace, const uint32_t start, const uint32_t end) const
+{
+	std::vector<uint32_t> waypoints;
+	for (uint32_t current = (uint32_t)transitionCells.size() + 1; current != INVALID_INDEX; current = workspace[current].previous)
+	{
+		// start and end nodes may be transitions themselves
+		const uint32_t cell = getCell(current, start, end);
+		if (waypoints.empty() || waypoints.back() != cell) waypoints.push_back(cell);
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+
+	return waypoints;
+}
+
+std::vector<uint32_t> HierarchicalAStar::refinePath(const ImplicitGridGraph& grid, const std::vector<uint32_t>& waypoints, SearchWorkspace& workspace) const
+{
+	std::vector<uint32_t> indexPath { waypoints.front() };
+	for (size_t i = 1; i < waypoints.size(); i++)
+	{
+		const std::vector<uint32_t> segment = refineSegment(grid, waypoints[i - 1], waypoints[i], workspace);
+		indexPath.insert(indexPath.end(), segment.begin(), segment.end());
+	}
+
+	return indexPath;
+}
+
+template<typename GraphType>
+SearchResult HierarchicalAStar::buildResult(const GraphType& graph, std::vector<uint32_t>&& indexPath, const float pathWeight, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+{
+	std::list<const Node*> path;
+	if constexpr (requires { graph.nodeAt(indexPath.front()); })
+	{
+		for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+	}
+
+	return SearchResult(true, pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+}
+
+template<typename GraphType>
+Coroutine HierarchicalAStar::searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	nanoseconds runtime = nanoseconds::zero();
+	auto startTime = high_resolution_clock().now();
+
+	// the layout is read on the first resume, environments assign it after creating the search
+	if (!layout || layout->getIndexCount() != graph.getIndexCount())
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("HierarchicalAStar was run without assigning the grid layout of the graph first.");
+	}
+	if (!hasLayoutWeights(graph))
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("HierarchicalAStar takes its weights from the layout, it can not search graphs whose weights changed.");
+	}
+	const shared_ptr<const ImplicitGridGraph> grid = layout;
+
+	// abstract nodes are logged as the grid cells they stand for
+	auto record = [&](const SearchWorkspace& workspace, const uint32_t index, const NodeState state)
+	{
+		const uint32_t previous = workspace[index].previous;
+		const Node* previousNode = previous != INVALID_INDEX ? graph.nodeAt(getCell(previous, start, end)) : nullptr;
+		searchLog.push_back({ graph.nodeAt(getCell(index, start, end)), state, make_shared<AStarPathData>(previousNode, workspace[index]) });
+	};
+
+	Connections connections;
+	size_t exploredCount = connect(*grid, start, end, workspace, connections);
+	const uint32_t startIndex = (uint32_t)transitionCells.size(), endIndex = startIndex + 1;
+	uint32_t current = INVALID_INDEX;
+	size_t previousSearchLogSize;
+
+	workspace.reset(transitionCells.size() + 2);
+	auto& discovered = workspace.estimateHeap;
+
+	workspace.discover(startIndex, INVALID_INDEX, 0, grid->getDistanceEstimate(start, end));
+	discovered.push(startIndex, { workspace[startIndex].heuristicValue, workspace[startIndex].heuristicValue });
+
+	while (!discovered.empty())
+	{
+		current = discovered.pop();
+		record(workspace, current, NodeState::CURRENT);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if(&incrementalSearch);
+		startTime = high_resolution_clock().now();
+		previousSearchLogSize = searchLog.size();
+
+		// if whole path is found -> break out of loop
+		if (current == endIndex) break;
+
+		expand(*grid, start, end, connections, workspace, current, record);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
+		startTime = high_resolution_clock().now();
+
+		workspace[current].explored = true;
+		exploredCount++;
+		record(workspace, current, NodeState::PROCESSED);
+	}
+
+	// no path found
+	if (current != endIndex)
+	{
+		runtime += high_resolution_clock().now() - startTime;
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
+		co_return;
+	}
+
+	const float pathWeight = workspace[endIndex].pathWeight;
+	vector<uint32_t> indexPath = refinePath(*grid, getWaypoints(workspace, start, end), workspace);
+	runtime += high_resolution_clock().now() - startTime;
+
+	searchResult = make_shared<SearchResult>(buildResult(graph, move(indexPath), pathWeight, exploredCount + 1, runtime));
+}
+
+template<typename GraphType>
+SearchResult HierarchicalAStar::runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, const bool refine) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	Connections connections;
+	size_t exploredCount = connect(grid, start, end, workspace, connections);
+	const uint32_t startIndex = (uint32_t)transitionCells.size(), endIndex = startIndex + 1;
+	uint32_t current = INVALID_INDEX;
+
+	workspace.reset(transitionCells.size() + 2);
+	auto& discovered = workspace.estimateHeap;
+
+	workspace.discover(startIndex, INVALID_INDEX, 0, grid.getDistanceEstimate(start, end));
+	discovered.push(startIndex, { workspace[startIndex].heuristicValue, workspace[startIndex].heuristicValue });
+
+	while (!discovered.empty())
+	{
+		current = discovered.pop();
+		if (current == endIndex) break;
+
+		expand(grid, start, end, connections, workspace, current, [](const SearchWorkspace&, const uint32_t, const NodeState) {});
+		workspace[current].explored = true;
+		exploredCount++;
+	}
+
+	// no path found
+	if (current != endIndex) return SearchResult(exploredCount, high_resolution_clock().now() - startTime);
+
+	// refinement reuses the workspace, so the abstract path has to be read first
+	const float pathWeight = workspace[endIndex].pathWeight;
+	vector<uint32_t> indexPath = getWaypoints(workspace, start, end);
+	if (refine) indexPath = refinePath(grid, indexPath, workspace);
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+	return buildResult(graph, move(indexPath), pathWeight, exploredCount + 1, runtime);
+}
+
+void HierarchicalAStar::setLayout(std::shared_ptr<const ImplicitGridGraph> layout)
+{
+	this->layout = move(layout);
+	abstractGraph.clear();
+	transitionCells.clear();
+	clusterTransitions.clear();
+	crossings.clear();
+	if (!this->layout) return;
+
+	const ImplicitGridGraph& grid = *this->layout;
+	clusterCountX = (grid.getGridWidth() + clusterSize - 1) / clusterSize;
+	clusterCountY = (grid.getGridHeight() + clusterSize - 1) / clusterSize;
+	clusterTransitions.resize((size_t)clusterCountX * clusterCountY);
+
+	// cells on two borders are shared by both of them
+	std::unordered_map<uint32_t, uint32_t> transitionIndices;
+	auto addTransition = [&](const int x, const int y)
+	{
+		const uint32_t cell = grid.getIndex(x, y);
+		const auto [iter, inserted] = transitionIndices.try_emplace(cell, (uint32_t)transitionCells.size());
+		if (inserted)
+		{
+			transitionCells.push_back(cell);
+			clusterTransitions[getClusterIndex(grid, cell)].push_back(iter->second);
+		}
+		return iter->second;
+	};
+
+	// transitions are spread evenly along the border, their positions only depend on the grid size so height changes keep them
+	auto addBorder = [&](const int x, const int y, const int directionX, const int directionY, const int length)
+	{
+		const int count = std::min(transitionsPerBorder, length);
+		for (int i = 0; i < count; i++)
+		{
+			const int offset = (2 * i + 1) * length / (2 * count);
+			const int borderX = x + directionY * offset, borderY = y + directionX * offset;
+			crossings.push_back({ addTransition(borderX - directionX, borderY - directionY), addTransition(borderX, borderY) });
+		}
+	};
+
+	for (int clusterX = 0; clusterX < clusterCountX; clusterX++)
+	{
+		for (int clusterY = 0; clusterY < clusterCountY; clusterY++)
+		{
+			const Cluster bounds = getCluster((uint32_t)(clusterX * clusterCountY + clusterY));
+			if (clusterX > 0) addBorder(bounds.x, bounds.y, 1, 0, bounds.height);
+			if (clusterY > 0) addBorder(bounds.x, bounds.y, 0, 1, bounds.width);
+		}
+	}
+
+	abstractGraph.addNodes(transitionCells.size());
+	for (const auto& crossing : crossings) buildCrossing(grid, crossing);
+
+	SearchWorkspace workspace;
+	for (uint32_t cluster = 0; cluster < clusterTransitions.size(); cluster++) buildCluster(grid, cluster, workspace);
+}
+
+void HierarchicalAStar::updateCells(const std::vector<uint32_t>& changedCells)
+{
+	if (!layout) return;
+	const ImplicitGridGraph& grid = *layout;
+
+	std::vector<bool> affected(clusterTransitions.size(), false);
+	for (const uint32_t cell : changedCells) affected[getClusterIndex(grid, cell)] = true;
+
+	// edges into a changed cell from another cluster are always border crossings, so neighbouring clusters keep their costs
+	SearchWorkspace workspace;
+	for (uint32_t cluster = 0; cluster < clusterTransitions.size(); cluster++)
+	{
+		if (affected[cluster]) buildCluster(grid, cluster, workspace);
+	}
+
+	for (const auto& crossing : crossings)
+	{
+		if (affected[getClusterIndex(grid, transitionCells[crossing.first])] || affected[getClusterIndex(grid, transitionCells[crossing.second])]) buildCrossing(grid, crossing);
+	}
+}
+
+SearchResult HierarchicalAStar::findAbstractPath(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	if (&grid != layout.get()) throw std::exception("HierarchicalAStar can only search the grid it was given as layout.");
+	return runIndexed(grid, grid, start, end, workspace, false);
+}
+
+std::vector<uint32_t> HierarchicalAStar::refineSegment(const ImplicitGridGraph& grid, const uint32_t from, const uint32_t to, SearchWorkspace& workspace) const
+{
+	if (&grid != layout.get()) throw std::exception("HierarchicalAStar can only search the grid it was given as layout.");
+	if (from == to) return {};
+
+	// waypoints in different clusters are the two sides of a border crossing
+	const uint32_t cluster = getClusterIndex(grid, from);
+	if (cluster != getClusterIndex(grid, to)) return { to };
+
+	searchCluster(grid, cluster, from, false, workspace, to);
+
+	const Cluster bounds = getCluster(cluster);
+	std::vector<uint32_t> segment;
+	for (uint32_t current = bounds.getLocalIndex(grid.getX(to), grid.getY(to)); workspace[current].previous != INVALID_INDEX; current = workspace[current].previous)
+	{
+		segment.push_back(grid.getIndex(bounds.x + current / bounds.height, bounds.y + current % bounds.height));
+	}
+	std::reverse(segment.begin(), segment.end());
+
+	return segment;
+}
+
+Coroutine HierarchicalAStar::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+Coroutine HierarchicalAStar::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+SearchResult HierarchicalAStar::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("HierarchicalAStar was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("HierarchicalAStar takes its weights from the layout, it can not search graphs whose weights changed.");
+	return runIndexed(graph, *layout, start.getIndex(), end.getIndex(), workspace, true);
+}
+
+SearchResult HierarchicalAStar::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("HierarchicalAStar was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("HierarchicalAStar takes its weights from the layout, it can not search graphs whose weights changed.");
+	return runIndexed(graph, *layout, start.getIndex(), end.getIndex(), workspace, true);
+}
+
+SearchResult HierarchicalAStar::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	if (&graph != layout.get()) throw std::exception("HierarchicalAStar can only search the grid it was given as layout.");
+	return runIndexed(graph, graph, start, end, workspace, true);
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	// hierarchical A* (HPA*), the layout is cut into square clusters whose borders are crossed at fixed transition cells
+	// queries are answered on the abstract graph of transitions and only the found legs are refined into grid cells
+	class HierarchicalAStar : public Pathfinder
+	{
+		private:
+
+		struct Cluster
+		{
+			int x, y, width, height;
+
+			size_t getCellCount() const { return (size_t)width * height; }
+			bool contains(const int cellX, const int cellY) const { return cellX >= x && cellY >= y && cellX < x + width && cellY < y + height; }
+			uint32_t getLocalIndex(const int cellX, const int cellY) const { return (uint32_t)((cellX - x) * height + cellY - y); }
+		};
+
+		// edges of the start and end node into the abstract graph, only valid for one query
+		struct Connections
+		{
+			uint32_t startCluster, endCluster;
+			std::vector<std::pair<uint32_t, float>> startEdges;
+			std::vector<std::pair<uint32_t, float>> endEdges;
+			float directWeight = std::numeric_limits<float>::infinity();
+		};
+
+		const int clusterSize;
+		const int transitionsPerBorder;
+		int clusterCountX = 0, clusterCountY = 0;
+
+		// nodes of the abstract graph are transition cells, edges are border crossings and the cheapest paths inside a cluster
+		Graph abstractGraph;
+		std::vector<uint32_t> transitionCells;
+		std::vector<std::vector<uint32_t>> clusterTransitions;
+		std::vector<std::pair<uint32_t, uint32_t>> crossings;
+
+		Cluster getCluster(const uint32_t cluster) const;
+		uint32_t getClusterIndex(const ImplicitGridGraph& grid, const uint32_t cell) const;
+		static void setAbstractEdge(Node& from, const Node& to, const float weight);
+
+		// Dijkstra restricted to one cluster, workspace slots are indexed by the local index of a cell
+		size_t searchCluster(const ImplicitGridGraph& grid, const uint32_t cluster, const uint32_t source, const bool incoming, SearchWorkspace& workspace, const uint32_t target = INVALID_INDEX) const;
+		void buildCluster(const ImplicitGridGraph& grid, const uint32_t cluster, SearchWorkspace& workspace);
+		void buildCrossing(const ImplicitGridGraph& grid, const std::pair<uint32_t, uint32_t>& crossing);
+
+		// abstract indices past the transitions stand for the start and the end node of a query
+		uint32_t getCell(const uint32_t abstractIndex, const uint32_t start, const uint32_t end) const;
+		size_t connect(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, Connections& connections) const;
+
+		template<typename Recorder>
+		void expand(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, const Connections& connections, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const;
+
+		std::vector<uint32_t> getWaypoints(const SearchWorkspace& workspace, const uint32_t start, const uint32_t end) const;
+		std::vector<uint32_t> refinePath(const ImplicitGridGraph& grid, const std::vector<uint32_t>& waypoints, SearchWorkspace& workspace) const;
+
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, std::vector<uint32_t>&& indexPath, const float pathWeight, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const;
+
+		template<typename GraphType>
+		Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType>
+		SearchResult runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, const bool refine) const;
+
+		protected:
+
+		std::shared_ptr<const ImplicitGridGraph> layout;
+
+		public:
+
+		HierarchicalAStar(const int clusterSize = 16, const int transitionsPerBorder = 3);
+
+		// builds the abstract graph, graphs have to be built from the layout with matching indices
+		virtual void setLayout(std::shared_ptr<const ImplicitGridGraph> layout);
+		const Graph& getAbstractGraph() const { return abstractGraph; }
+		uint32_t getTransitionCell(const uint32_t abstractIndex) const { return transitionCells[abstractIndex]; }
+
+		// has to be called after heights of the layout changed, only the clusters containing the given cells are searched again
+		// must not run while searches are in flight
+		void updateCells(const std::vector<uint32_t>& changedCells);
+
+		// waypoints of the abstract path in indexPath, the weight is already the weight of the refined path
+		SearchResult findAbstractPath(const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const;
+		// cells after from up to and including to, consecutive waypoints either share a cluster or are neighbours
+		std::vector<uint32_t> refineSegment(const ImplicitGridGraph& grid, const uint32_t from, const uint32_t to, SearchWorkspace& workspace) const;
+
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+	};
+}
\ No newline at end of file
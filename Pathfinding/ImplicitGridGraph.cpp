@@ -0,0 +1,30 @@
+#include "ImplicitGridGraph.h"
+
+using namespace Pathfinding;
+
+ImplicitGridGraph::ImplicitGridGraph(const int width, const int height, const GridConnectivity connectivity, std::vector<int>&& heightMap)
+	: width(width), height(height), connectivity(connectivity), heightMap(move(heightMap))
+{
+	if (width <= 0 || height <= 0) throw std::exception("Width and height of grid have to be greater than 0.");
+	if (this->heightMap.size() != (size_t)width * height) throw std::exception("Heightmap does not match the size of the grid.");
+}
+
+void ImplicitGridGraph::setHeight(const int x, const int y, const int height)
+{
+	if (height < 0 || height > HEIGHTMAP_STEPS) throw std::exception("Height has to be between 0 and HEIGHTMAP_STEPS.");
+	heightMap[(size_t)x * this->height + y] = height;
+}
+
+float ImplicitGridGraph::getDistanceEstimate(const uint32_t from, const uint32_t to) const
+{
+	// heights range from 0 to HEIGHTMAP_STEPS, so the steepest descent is the cheapest step
+	const float straightWeight = getEdgeWeight(HEIGHTMAP_STEPS, 0);
+	const float diagonalWeight = getEdgeWeight(HEIGHTMAP_STEPS, 0, true);
+
+	const int distanceX = std::abs(getX(to) - getX(from)), distanceY = std::abs(getY(to) - getY(from));
+	if (connectivity == GridConnectivity::FourNeighbours) return (distanceX + distanceY) * straightWeight;
+
+	// octile distance
+	const int diagonalSteps = std::min(distanceX, distanceY);
+	return diagonalSteps * diagonalWeight + (distanceX + distanceY - 2 * diagonalSteps) * straightWeight;
+}
\ No newline at end of file
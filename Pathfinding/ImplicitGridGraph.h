@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include "Node.h"
+
+namespace Pathfinding
+{
+	constexpr int HEIGHTMAP_STEPS = 8;
+
+	enum class GridConnectivity
+	{
+		FourNeighbours = 4,
+		EightNeighbours = 8
+	};
+
+	// heightmap grid without any Node or Edge objects, neighbours and weights are computed on the fly while iterating
+	// cells are stored column by column so cell (x, y) has index x * height + y
+	class ImplicitGridGraph
+	{
+		private:
+
+		struct Offset
+		{
+			int x, y;
+		};
+
+		// straight neighbours first, so four neighbour grids only use the first half
+		static constexpr Offset offsets[] = { { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 } };
+
+		const int width, height;
+		const GridConnectivity connectivity;
+		std::vector<int> heightMap;
+
+		public:
+
+		class EdgeRange
+		{
+			private:
+
+			const ImplicitGridGraph& graph;
+			const int x, y;
+			const bool incoming;
+
+			public:
+
+			struct Iterator
+			{
+				const ImplicitGridGraph* graph;
+				int x, y;
+				bool incoming;
+				size_t offset;
+
+				// skip offsets that leave the grid
+				void skipOutside()
+				{
+					while (offset < (size_t)graph->connectivity)
+					{
+						const int neighbourX = x + offsets[offset].x, neighbourY = y + offsets[offset].y;
+						if (neighbourX >= 0 && neighbourY >= 0 && neighbourX < graph->width && neighbourY < graph->height) break;
+						offset++;
+					}
+				}
+
+				IndexedEdge operator*() const
+				{
+					const int neighbourX = x + offsets[offset].x, neighbourY = y + offsets[offset].y;
+					const int height = graph->getHeight(x, y), neighbourHeight = graph->getHeight(neighbourX, neighbourY);
+
+					// incoming edges are walked backwards, so their weight is the one of the step from the neighbour
+					const float weight = incoming ? getEdgeWeight(neighbourHeight, height, offset >= 4) : getEdgeWeight(height, neighbourHeight, offset >= 4);
+					return { graph->getIndex(neighbourX, neighbourY), weight };
+				}
+				Iterator& operator++() { offset++; skipOutside(); return *this; }
+				bool operator!=(const Iterator& other) const { return offset != other.offset; }
+			};
+
+			EdgeRange(const ImplicitGridGraph& graph, const int x, const int y, const bool incoming) : graph(graph), x(x), y(y), incoming(incoming) {}
+
+			Iterator begin() const
+			{
+				Iterator iterator { &graph, x, y, incoming, 0 };
+				iterator.skipOutside();
+				return iterator;
+			}
+			Iterator end() const { return { &graph, x, y, incoming, (size_t)graph.connectivity }; }
+		};
+
+		ImplicitGridGraph(const int width, const int height, const GridConnectivity connectivity, std::vector<int>&& heightMap);
+
+		int getGridWidth() const { return width; }
+		int getGridHeight() const { return height; }
+		GridConnectivity getConnectivity() const { return connectivity; }
+		const std::vector<int>& getHeightMap() const { return heightMap; }
+		int getHeight(const int x, const int y) const { return heightMap[(size_t)x * height + y]; }
+
+		// heights outside of 0 to HEIGHTMAP_STEPS would break the weight bounds of the queues and the distance estimate
+		// searches that preprocessed this grid as their layout have to be told, see updateCells of JumpPointSearchPlus, HierarchicalAStar and DStarLite
+		void setHeight(const int x, const int y, const int height);
+
+		size_t getIndexCount() const { return heightMap.size(); }
+		uint32_t getIndex(const int x, const int y) const { return (uint32_t)((size_t)x * height + y); }
+		int getX(const uint32_t index) const { return (int)(index / height); }
+		int getY(const uint32_t index) const { return (int)(index % height); }
+		EdgeRange getEdges(const uint32_t index) const { return EdgeRange(*this, getX(index), getY(index), false); }
+		EdgeRange getIncomingEdges(const uint32_t index) const { return EdgeRange(*this, getX(index), getY(index), true); }
+
+		// lower bound of the path weight between two cells, built from the cheapest possible straight and diagonal step
+		float getDistanceEstimate(const uint32_t from, const uint32_t to) const;
+
+		static float getEdgeWeight(const int fromHeight, const int toHeight, const bool diagonal = false)
+		{
+			// going downhill costs half as much as going uphill, diagonal steps cover a longer distance
+			int gradient = toHeight - fromHeight;
+			if (gradient < 0) gradient /= 2;
+
+			return gradient + (diagonal ? (float)(HEIGHTMAP_STEPS * std::numbers::sqrt2) : (float)HEIGHTMAP_STEPS);
+		}
+	};
+
+	// incoming edges of an implicit grid seen as a graph of their own, searches running backwards walk it like any other graph
+	struct ImplicitIncomingEdges
+	{
+		const ImplicitGridGraph& graph;
+
+		size_t getIndexCount() const { return graph.getIndexCount(); }
+		ImplicitGridGraph::EdgeRange getEdges(const uint32_t index) const { return graph.getIncomingEdges(index); }
+	};
+}
\ No newline at end of file
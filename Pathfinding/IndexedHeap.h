@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Pathfinding
+{
+	// d-ary min heap over node indices, keys are stored inline and every index knows its heap position for decrease-key
+	template<typename Key, size_t Arity = 4>
+	class IndexedHeap
+	{
+		private:
+
+		struct Entry
+		{
+			Key key;
+			uint32_t index;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<uint32_t> positions;
+
+		void siftUp(size_t position)
+		{
+			const Entry entry = entries[position];
+			while (position > 0)
+			{
+				const size_t parent = (position - 1) / Arity;
+				if (!(entry.key < entries[parent].key)) break;
+
+				entries[position] = entries[parent];
+				positions[entries[position].index] = (uint32_t)position;
+				position = parent;
+			}
+			entries[position] = entry;
+			positions[entry.index] = (uint32_t)position;
+		}
+
+		void siftDown(size_t position)
+		{
+			const Entry entry = entries[position];
+			while (true)
+			{
+				const size_t firstChild = position * Arity + 1;
+				if (firstChild >= entries.size()) break;
+
+				const size_t lastChild = firstChild + Arity < entries.size() ? firstChild + Arity : entries.size();
+				size_t bestChild = firstChild;
+				for (size_t child = firstChild + 1; child < lastChild; child++)
+				{
+					if (entries[child].key < entries[bestChild].key) bestChild = child;
+				}
+				if (!(entries[bestChild].key < entry.key)) break;
+
+				entries[position] = entries[bestChild];
+				positions[entries[position].index] = (uint32_t)position;
+				position = bestChild;
+			}
+			entries[position] = entry;
+			positions[entry.index] = (uint32_t)position;
+		}
+
+		public:
+
+		// positions are not cleared, an index only counts as contained if its entry points back at it
+		void reset(const size_t indexCount)
+		{
+			entries.clear();
+			if (positions.size() < indexCount) positions.resize(indexCount);
+		}
+
+		bool empty() const { return entries.empty(); }
+		size_t size() const { return entries.size(); }
+		uint32_t top() const { return entries[0].index; }
+		const Key& topKey() const { return entries[0].key; }
+
+		bool contains(const uint32_t index) const
+		{
+			const uint32_t position = positions[index];
+			return position < entries.size() && entries[position].index == index;
+		}
+
+		void push(const uint32_t index, const Key& key)
+		{
+			entries.push_back({ key, index });
+			siftUp(entries.size() - 1);
+		}
+
+		void decrease(const uint32_t index, const Key& key)
+		{
+			const uint32_t position = positions[index];
+			entries[position].key = key;
+			siftUp(position);
+		}
+
+		void pushOrDecrease(const uint32_t index, const Key& key)
+		{
+			if (contains(index)) decrease(index, key);
+			else push(index, key);
+		}
+
+		// moves an index to a key in either direction
+		void update(const uint32_t index, const Key& key)
+		{
+			const uint32_t position = positions[index];
+			const bool decreased = key < entries[position].key;
+			entries[position].key = key;
+			if (decreased) siftUp(position);
+			else siftDown(position);
+		}
+
+		void erase(const uint32_t index)
+		{
+			const uint32_t position = positions[index];
+			const Entry last = entries.back();
+			entries.pop_back();
+			if (position == entries.size()) return;
+
+			// the last entry fills the gap and may belong above or below it
+			entries[position] = last;
+			positions[last.index] = position;
+			if (position > 0 && last.key < entries[(position - 1) / Arity].key) siftUp(position);
+			else siftDown(position);
+		}
+
+		uint32_t pop()
+		{
+			const uint32_t index = entries[0].index;
+			entries[0] = entries.back();
+			entries.pop_back();
+			if (!entries.empty()) siftDown(0);
+			return index;
+		}
+	};
+}
\ No newline at end of file
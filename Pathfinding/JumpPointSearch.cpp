@@ -0,0 +1,285 @@
+#include "JumpPointSearch.h"
+#include "AStar.h"
+
+using namespace Pathfinding;
+
+template<typename GraphType, typename Recorder>
+void JumpPointSearch::expand(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t end, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const
+{
+	const int x = grid.getX(current), y = grid.getY(current);
+	const int height = grid.getHeight(x, y);
+
+	auto visit = [&](const uint32_t neighbour, const float weight)
+	{
+		const float neighbourPathWeight = workspace[current].pathWeight + weight;
+
+		// discover new jump points
+		if (!workspace.isKnown(neighbour))
+		{
+			workspace.discover(neighbour, current, neighbourPathWeight, grid.getDistanceEstimate(neighbour, end));
+			workspace.estimateHeap.push(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+
+		// if pathWeight of jump point is worse than current path -> replace pathData and move it up in the queue, explored nodes are reopened
+		else if (workspace[neighbour].pathWeight > neighbourPathWeight)
+		{
+			workspace[neighbour].previous = current;
+			workspace[neighbour].pathWeight = neighbourPathWeight;
+			workspace[neighbour].explored = false;
+			workspace.estimateHeap.pushOrDecrease(neighbour, { neighbourPathWeight + workspace[neighbour].heuristicValue, workspace[neighbour].heuristicValue });
+			record(graph, workspace, neighbour, NodeState::DISCOVERED);
+		}
+	};
+
+	auto jumpTo = [&](const int directionX, const int directionY)
+	{
+		int steps;
+		const uint32_t jumpPoint = jump(grid, x, y, directionX, directionY, end, steps);
+		if (jumpPoint != INVALID_INDEX) visit(jumpPoint, steps * ImplicitGridGraph::getEdgeWeight(height, height));
+	};
+
+	// the start node, exit cells and eight neighbour grids get every neighbour, only steps within the region are turned into jumps
+	const uint32_t previous = workspace[current].previous;
+	const bool pruning = grid.getConnectivity() == GridConnectivity::FourNeighbours;
+	if (previous == INVALID_INDEX || !pruning || isExit(grid, x, y))
+	{
+		for (const auto [neighbour, weight] : graph.getEdges(current))
+		{
+			const int neighbourX = grid.getX(neighbour), neighbourY = grid.getY(neighbour);
+			if (pruning && grid.getHeight(neighbourX, neighbourY) == height) jumpTo(neighbourX - x, neighbourY - y);
+			else visit(neighbour, weight);
+		}
+		return;
+	}
+
+	// jumps are straight, so the direction of arrival follows from the previous jump point
+	const int directionX = (x > grid.getX(previous)) - (x < grid.getX(previous));
+	const int directionY = (y > grid.getY(previous)) - (y < grid.getY(previous));
+	jumpTo(directionX, directionY);
+
+	// horizontal moves may turn at every jump point, vertical moves only towards forced neighbours
+	if (directionY == 0)
+	{
+		jumpTo(0, 1);
+		jumpTo(0, -1);
+	}
+	else
+	{
+		for (const int side : { -1, 1 })
+		{
+			if (isFree(grid, x + side, y, height) && !isFree(grid, x + side, y - directionY, height)) jumpTo(side, 0);
+		}
+	}
+}
+
+template<typename GraphType>
+SearchResult JumpPointSearch::buildResult(const GraphType& graph, const ImplicitGridGraph& grid, const SearchWorkspace& workspace, const uint32_t end, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+{
+	std::vector<uint32_t> jumpPoints;
+	for (uint32_t current = end; current != INVALID_INDEX; current = workspace[current].previous)
+	{
+		jumpPoints.push_back(current);
+	}
+	std::reverse(jumpPoints.begin(), jumpPoints.end());
+
+	// fill in the cells skipped by every jump
+	std::vector<uint32_t> indexPath { jumpPoints.front() };
+	for (size_t i = 1; i < jumpPoints.size(); i++)
+	{
+		int x = grid.getX(jumpPoints[i - 1]), y = grid.getY(jumpPoints[i - 1]);
+		const int targetX = grid.getX(jumpPoints[i]), targetY = grid.getY(jumpPoints[i]);
+		while (x != targetX || y != targetY)
+		{
+			x += (targetX > x) - (targetX < x);
+			y += (targetY > y) - (targetY < y);
+			indexPath.push_back(grid.getIndex(x, y));
+		}
+	}
+
+	std::list<const Node*> path;
+	if constexpr (requires { graph.nodeAt(end); })
+	{
+		for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+	}
+
+	return SearchResult(true, workspace[end].pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+}
+
+template<typename GraphType>
+Coroutine JumpPointSearch::searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	nanoseconds runtime = nanoseconds::zero();
+	auto startTime = high_resolution_clock().now();
+
+	// the layout is read on the first resume, environments assign it after creating the search
+	if (!layout || layout->getIndexCount() != graph.getIndexCount())
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("JumpPointSearch was run without assigning the grid layout of the graph first.");
+	}
+	if (!hasLayoutWeights(graph))
+	{
+		searchResult = make_shared<SearchResult>();
+		throw exception("JumpPointSearch takes the weights of jumps from the layout, it can not search graphs whose weights changed.");
+	}
+	const shared_ptr<const ImplicitGridGraph> grid = layout;
+
+	const SearchRecorder<AStarPathData> record { searchLog };
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+	size_t previousSearchLogSize;
+
+	workspace.reset(graph.getIndexCount());
+	auto& discovered = workspace.estimateHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0, grid->getDistanceEstimate(start, end));
+	discovered.push(start, { workspace[start].heuristicValue, workspace[start].heuristicValue });
+
+	while (!discovered.empty())
+	{
+		current = discovered.pop();
+		record(graph, workspace, current, NodeState::CURRENT);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if(&incrementalSearch);
+		startTime = high_resolution_clock().now();
+		previousSearchLogSize = searchLog.size();
+
+		// if whole path is found -> break out of loop
+		if (current == end) break;
+
+		expand(graph, *grid, end, workspace, current, record);
+
+		// allowing breakpoint (not part of the algorithm)
+		runtime += high_resolution_clock().now() - startTime;
+		co_await suspend_if([&]() { return incrementalSearch && searchLog.size() != previousSearchLogSize; });
+		startTime = high_resolution_clock().now();
+
+		workspace[current].explored = true;
+		exploredCount++;
+		record(graph, workspace, current, NodeState::PROCESSED);
+	}
+
+	runtime += high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (current != end)
+	{
+		searchResult = make_shared<SearchResult>(exploredCount, runtime);
+		co_return;
+	}
+
+	searchResult = make_shared<SearchResult>(buildResult(graph, *grid, workspace, end, exploredCount + 1, runtime));
+}
+
+template<typename GraphType>
+SearchResult JumpPointSearch::runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+
+	uint32_t current = INVALID_INDEX;
+	size_t exploredCount = 0;
+
+	workspace.reset(graph.getIndexCount());
+	auto& discovered = workspace.estimateHeap;
+
+	workspace.discover(start, INVALID_INDEX, 0, grid.getDistanceEstimate(start, end));
+	discovered.push(start, { workspace[start].heuristicValue, workspace[start].heuristicValue });
+
+	while (!discovered.empty())
+	{
+		current = discovered.pop();
+		if (current == end) break;
+
+		expand(graph, grid, end, workspace, current, NullRecorder {});
+		workspace[current].explored = true;
+		exploredCount++;
+	}
+
+	const nanoseconds runtime = high_resolution_clock().now() - startTime;
+
+	// no path found
+	if (current != end) return SearchResult(exploredCount, runtime);
+
+	return buildResult(graph, grid, workspace, end, exploredCount + 1, runtime);
+}
+
+bool JumpPointSearch::isFree(const ImplicitGridGraph& grid, const int x, const int y, const int height)
+{
+	return x >= 0 && y >= 0 && x < grid.getGridWidth() && y < grid.getGridHeight() && grid.getHeight(x, y) == height;
+}
+
+bool JumpPointSearch::isExit(const ImplicitGridGraph& grid, const int x, const int y)
+{
+	const int height = grid.getHeight(x, y);
+	return (x > 0 && grid.getHeight(x - 1, y) != height) || (x + 1 < grid.getGridWidth() && grid.getHeight(x + 1, y) != height)
+		|| (y > 0 && grid.getHeight(x, y - 1) != height) || (y + 1 < grid.getGridHeight() && grid.getHeight(x, y + 1) != height);
+}
+
+uint32_t JumpPointSearch::jump(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY, const uint32_t end, int& steps) const
+{
+	const int height = grid.getHeight(x, y);
+	for (steps = 1; ; steps++)
+	{
+		const int currentX = x + directionX * steps, currentY = y + directionY * steps;
+		if (!isFree(grid, currentX, currentY, height)) return INVALID_INDEX;
+
+		// the end node and exit cells always stop a jump
+		const uint32_t current = grid.getIndex(currentX, currentY);
+		if (current == end || isExit(grid, currentX, currentY)) return current;
+
+		// vertical jumps stop next to forced neighbours, cells that were blocked beside the previous cell
+		if (directionX == 0)
+		{
+			for (const int side : { -1, 1 })
+			{
+				if (isFree(grid, currentX + side, currentY, height) && !isFree(grid, currentX + side, currentY - directionY, height)) return current;
+			}
+		}
+
+		// horizontal jumps stop where a vertical jump would find something
+		else
+		{
+			int verticalSteps;
+			if (jump(grid, currentX, currentY, 0, 1, end, verticalSteps) != INVALID_INDEX) return current;
+			if (jump(grid, currentX, currentY, 0, -1, end, verticalSteps) != INVALID_INDEX) return current;
+		}
+	}
+}
+
+Coroutine JumpPointSearch::search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+Coroutine JumpPointSearch::search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch)
+{
+	return searchIndexed(graph, start.getIndex(), end.getIndex(), workspace, incrementalSearch);
+}
+
+SearchResult JumpPointSearch::runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("JumpPointSearch was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("JumpPointSearch takes the weights of jumps from the layout, it can not search graphs whose weights changed.");
+	return runIndexed(graph, *layout, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult JumpPointSearch::runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const
+{
+	if (!layout || layout->getIndexCount() != graph.getIndexCount()) throw std::exception("JumpPointSearch was run without assigning the grid layout of the graph first.");
+	if (!hasLayoutWeights(graph)) throw std::exception("JumpPointSearch takes the weights of jumps from the layout, it can not search graphs whose weights changed.");
+	return runIndexed(graph, *layout, start.getIndex(), end.getIndex(), workspace);
+}
+
+SearchResult JumpPointSearch::runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const
+{
+	return runIndexed(graph, graph, start, end, workspace);
+}
\ No newline at end of file
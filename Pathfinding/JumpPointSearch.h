@@ -0,0 +1,48 @@
+#pragma once
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	// A* over the jump points of a four neighbour grid, cells of equal height form uniform regions that are crossed in straight jumps
+	// cells next to a different height are expanded normally, eight neighbour grids fall back to plain A* expansion
+	class JumpPointSearch : public Pathfinder
+	{
+		private:
+
+		template<typename GraphType, typename Recorder>
+		void expand(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t end, SearchWorkspace& workspace, const uint32_t current, const Recorder& record) const;
+
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, const ImplicitGridGraph& grid, const SearchWorkspace& workspace, const uint32_t end, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const;
+
+		template<typename GraphType>
+		Coroutine searchIndexed(const GraphType& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace, bool& incrementalSearch);
+
+		template<typename GraphType>
+		SearchResult runIndexed(const GraphType& graph, const ImplicitGridGraph& grid, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const;
+
+		protected:
+
+		std::shared_ptr<const ImplicitGridGraph> layout;
+
+		// free cells are inside the grid and share the height of the region a jump started in
+		static bool isFree(const ImplicitGridGraph& grid, const int x, const int y, const int height);
+		// exit cells have a neighbour of another height, paths can only leave a region through them
+		static bool isExit(const ImplicitGridGraph& grid, const int x, const int y);
+
+		// walks from (x, y) in one straight direction until a jump point is found, returns INVALID_INDEX on dead ends
+		virtual uint32_t jump(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY, const uint32_t end, int& steps) const;
+
+		public:
+
+		// graphs have to be built from the layout with matching indices, jumps take their weights from the layout
+		// so graphs whose weights changed since they were built are refused, single steps read the weights of the searched graph
+		virtual void setLayout(std::shared_ptr<const ImplicitGridGraph> layout) { this->layout = move(layout); }
+
+		Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) override;
+		SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const override;
+		SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const override;
+	};
+}
\ No newline at end of file
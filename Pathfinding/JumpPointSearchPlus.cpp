@@ -0,0 +1,131 @@
+#include "JumpPointSearchPlus.h"
+
+using namespace Pathfinding;
+
+void JumpPointSearchPlus::fill(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY)
+{
+	// distance of a cell follows from the distance of the next cell in the same direction
+	const int nextX = x + directionX, nextY = y + directionY;
+	const int regionHeight = grid.getHeight(x, y);
+	int32_t& distance = jumpDistances[getDirectionIndex(directionX, directionY)][grid.getIndex(x, y)];
+
+	if (!isFree(grid, nextX, nextY, regionHeight)) { distance = 0; return; }
+
+	// same stop conditions as the cell by cell jump, except for the end node
+	bool stop = isExit(grid, nextX, nextY);
+	if (directionX == 0)
+	{
+		for (const int side : { -1, 1 })
+		{
+			if (isFree(grid, nextX + side, nextY, regionHeight) && !isFree(grid, x + side, y, regionHeight)) stop = true;
+		}
+	}
+	else
+	{
+		const uint32_t next = grid.getIndex(nextX, nextY);
+		stop = stop || jumpDistances[getDirectionIndex(0, 1)][next] > 0 || jumpDistances[getDirectionIndex(0, -1)][next] > 0;
+	}
+
+	const int32_t nextDistance = jumpDistances[getDirectionIndex(directionX, directionY)][grid.getIndex(nextX, nextY)];
+	distance = stop ? 1 : (nextDistance > 0 ? nextDistance + 1 : nextDistance - 1);
+}
+
+void JumpPointSearchPlus::fillColumn(const ImplicitGridGraph& grid, const int x)
+{
+	for (int y = grid.getGridHeight() - 1; y >= 0; y--) fill(grid, x, y, 0, 1);
+	for (int y = 0; y < grid.getGridHeight(); y++) fill(grid, x, y, 0, -1);
+}
+
+void JumpPointSearchPlus::fillRow(const ImplicitGridGraph& grid, const int y)
+{
+	for (int x = grid.getGridWidth() - 1; x >= 0; x--) fill(grid, x, y, 1, 0);
+	for (int x = 0; x < grid.getGridWidth(); x++) fill(grid, x, y, -1, 0);
+}
+
+void JumpPointSearchPlus::preprocess(const ImplicitGridGraph& grid)
+{
+	for (auto& distances : jumpDistances) distances.assign(grid.getIndexCount(), 0);
+
+	// vertical distances first, horizontal jumps stop where a vertical jump finds something
+	for (int x = 0; x < grid.getGridWidth(); x++) fillColumn(grid, x);
+	for (int y = 0; y < grid.getGridHeight(); y++) fillRow(grid, y);
+}
+
+uint32_t JumpPointSearchPlus::jump(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY, const uint32_t end, int& steps) const
+{
+	if (&grid != layout.get() || jumpDistances[0].empty()) return JumpPointSearch::jump(grid, x, y, directionX, directionY, end, steps);
+
+	const int32_t distance = jumpDistances[getDirectionIndex(directionX, directionY)][grid.getIndex(x, y)];
+	const int freeSteps = std::abs(distance);
+
+	// the end node is unknown to the table, so check if the jump passes its column or reaches it directly
+	const int endX = grid.getX(end), endY = grid.getY(end);
+	const int endStepsX = (endX - x) * directionX, endStepsY = (endY - y) * directionY;
+	if (directionX == 0 && endX == x && endStepsY >= 1 && endStepsY <= freeSteps)
+	{
+		steps = endStepsY;
+		return end;
+	}
+	if (directionY == 0 && endStepsX >= 1 && endStepsX <= freeSteps)
+	{
+		steps = endStepsX;
+		return grid.getIndex(endX, y);
+	}
+
+	if (distance <= 0) return INVALID_INDEX;
+
+	steps = distance;
+	return grid.getIndex(x + directionX * distance, y + directionY * distance);
+}
+
+void JumpPointSearchPlus::setLayout(std::shared_ptr<const ImplicitGridGraph> layout)
+{
+	JumpPointSearch::setLayout(move(layout));
+
+	// eight neighbour grids never jump
+	for (auto& distances : jumpDistances) distances.clear();
+	if (this->layout && this->layout->getConnectivity() == GridConnectivity::FourNeighbours) preprocess(*this->layout);
+}
+
+void JumpPointSearchPlus::updateCells(const std::vector<uint32_t>& changedCells)
+{
+	if (!layout || jumpDistances[0].empty()) return;
+	const ImplicitGridGraph& grid = *layout;
+	const int width = grid.getGridWidth(), height = grid.getGridHeight();
+
+	// a cell decides the exits and forced neighbours of the cells beside it, so the neighbouring columns and rows change as well
+	std::vector<bool> columns(width, false), rows(height, false);
+	for (const uint32_t cell : changedCells)
+	{
+		const int x = grid.getX(cell), y = grid.getY(cell);
+		for (int offset = -1; offset <= 1; offset++)
+		{
+			if (x + offset >= 0 && x + offset < width) columns[x + offset] = true;
+			if (y + offset >= 0 && y + offset < height) rows[y + offset] = true;
+		}
+	}
+
+	// horizontal jumps stop where a vertical jump finds something, so every row crossing a changed vertical distance is filled again
+	std::vector<int32_t> previousUp(height), previousDown(height);
+	for (int x = 0; x < width; x++)
+	{
+		if (!columns[x]) continue;
+
+		for (int y = 0; y < height; y++)
+		{
+			previousUp[y] = jumpDistances[getDirectionIndex(0, 1)][grid.getIndex(x, y)];
+			previousDown[y] = jumpDistances[getDirectionIndex(0, -1)][grid.getIndex(x, y)];
+		}
+		fillColumn(grid, x);
+		for (int y = 0; y < height; y++)
+		{
+			const uint32_t index = grid.getIndex(x, y);
+			if (jumpDistances[getDirectionIndex(0, 1)][index] != previousUp[y] || jumpDistances[getDirectionIndex(0, -1)][index] != previousDown[y]) rows[y] = true;
+		}
+	}
+
+	for (int y = 0; y < height; y++)
+	{
+		if (rows[y]) fillRow(grid, y);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include "JumpPointSearch.h"
+
+namespace Pathfinding
+{
+	// JumpPointSearch with the jump distances of every cell precomputed when the layout is assigned, other grids are still walked cell by cell
+	class JumpPointSearchPlus : public JumpPointSearch
+	{
+		private:
+
+		// per direction, positive distances reach a jump point and the others count the free steps until a dead end
+		std::vector<int32_t> jumpDistances[4];
+
+		static size_t getDirectionIndex(const int directionX, const int directionY) { return directionX != 0 ? (directionX > 0 ? 1 : 0) : (directionY > 0 ? 3 : 2); }
+		void fill(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY);
+		void fillColumn(const ImplicitGridGraph& grid, const int x);
+		void fillRow(const ImplicitGridGraph& grid, const int y);
+		void preprocess(const ImplicitGridGraph& grid);
+
+		protected:
+
+		uint32_t jump(const ImplicitGridGraph& grid, const int x, const int y, const int directionX, const int directionY, const uint32_t end, int& steps) const override;
+
+		public:
+
+		void setLayout(std::shared_ptr<const ImplicitGridGraph> layout) override;
+
+		// has to be called after heights of the layout changed, only the rows and columns around the given cells are filled again
+		// must not run while searches are in flight
+		void updateCells(const std::vector<uint32_t>& changedCells);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "Landmarks.h"
+#include <cmath>
+#include <future>
+#include <random>
+#include "SearchWorkspace.h"
+
+using namespace Pathfinding;
+
+// one-to-all Dijkstra, unreachable nodes keep an infinite distance and the shortest path tree stays in the workspace
+template<typename GraphType>
+static void computeDistances(const GraphType& graph, const uint32_t source, SearchWorkspace& workspace, std::vector<float>& distances, std::vector<uint32_t>* settleOrder = nullptr)
+{
+	const size_t indexCount = graph.getIndexCount();
+	distances.assign(indexCount, std::numeric_limits<float>::infinity());
+	if (settleOrder) settleOrder->clear();
+
+	workspace.reset(indexCount);
+	auto& discovered = workspace.pathWeightHeap;
+	workspace.discover(source, INVALID_INDEX, 0);
+	discovered.push(source, 0);
+
+	while (!discovered.empty())
+	{
+		const uint32_t current = discovered.pop();
+		workspace[current].explored = true;
+		distances[current] = workspace[current].pathWeight;
+		if (settleOrder) settleOrder->push_back(current);
+
+		for (const auto [neighbour, weight] : graph.getEdges(current))
+		{
+			const float neighbourPathWeight = workspace[current].pathWeight + weight;
+			if (!workspace.isKnown(neighbour))
+			{
+				workspace.discover(neighbour, current, neighbourPathWeight);
+				discovered.push(neighbour, neighbourPathWeight);
+			}
+			else if (!workspace[neighbour].explored && workspace[neighbour].pathWeight > neighbourPathWeight)
+			{
+				workspace[neighbour].previous = current;
+				workspace[neighbour].pathWeight = neighbourPathWeight;
+				discovered.decrease(neighbour, neighbourPathWeight);
+			}
+		}
+	}
+}
+
+Landmarks::Landmarks(const Graph& graph, const size_t count, const LandmarkSelection selection, const unsigned int seed)
+{
+	const CompactGraph forward(graph);
+	const CompactGraph reverse(graph, EdgeDirection::Incoming);
+	build(forward, reverse, count, selection, seed);
+	graphVersion = graph.getVersion();
+}
+
+Landmarks::Landmarks(const ImplicitGridGraph& graph, const size_t count, const LandmarkSelection selection, const unsigned int seed)
+{
+	build(graph, ImplicitIncomingEdges { graph }, count, selection, seed);
+}
+
+template<typename GraphType, typename ReverseType>
+void Landmarks::build(const GraphType& graph, const ReverseType& reverse, const size_t count, const LandmarkSelection selection, const unsigned int seed)
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+	const float infinity = numeric_limits<float>::infinity();
+	indexCount = graph.getIndexCount();
+
+	vector<uint32_t> candidates;
+	for (uint32_t index = 0; index < indexCount; index++)
+	{
+		if constexpr (requires { graph.nodeAt(index); })
+		{
+			if (!graph.nodeAt(index)) continue;
+		}
+		candidates.push_back(index);
+	}
+	if (candidates.empty()) return;
+
+	mt19937 random(seed);
+	uniform_int_distribution<size_t> candidateDistribution(0, candidates.size() - 1);
+
+	SearchWorkspace workspace;
+	vector<float> rootDistances;
+	vector<uint32_t> settleOrder;
+
+	// selection needs the distances from all previous landmarks, the distances to a landmark are only needed by the final tables
+	vector<vector<float>> forwardTables;
+	vector<future<vector<float>>> backwardTables;
+	vector<float> minDistances(indexCount, infinity);
+	vector<bool> isLandmark(indexCount, false);
+
+	// farthest pick: the reachable node farthest from all landmarks, the first one is the node farthest from a random root
+	auto pickFarthest = [&]()
+	{
+		if (landmarks.empty())
+		{
+			computeDistances(graph, candidates[candidateDistribution(random)], workspace, rootDistances);
+		}
+		const vector<float>& distances = landmarks.empty() ? rootDistances : minDistances;
+
+		uint32_t farthest = INVALID_INDEX;
+		for (const uint32_t index : candidates)
+		{
+			if (distances[index] == infinity || isLandmark[index]) continue;
+			if (farthest == INVALID_INDEX || distances[index] > distances[farthest]) farthest = index;
+		}
+		return farthest;
+	};
+
+	// avoid pick: in the shortest path tree of a random root, every node is weighted by how badly the landmarks bound its distance to the root
+	// the heaviest subtree without a landmark is followed down to a leaf, so the new landmark lies behind the worst covered region
+	vector<double> subtreeWeights(indexCount);
+	vector<bool> blocked(indexCount);
+	vector<uint32_t> bestChildren(indexCount);
+	auto pickAvoid = [&]()
+	{
+		const uint32_t root = candidates[candidateDistribution(random)];
+		computeDistances(graph, root, workspace, rootDistances, &settleOrder);
+
+		for (const uint32_t index : settleOrder)
+		{
+			float lowerBound = 0;
+			for (const vector<float>& fromLandmark : forwardTables)
+			{
+				if (fromLandmark[index] != infinity && fromLandmark[root] != infinity) lowerBound = max(lowerBound, fromLandmark[index] - fromLandmark[root]);
+			}
+			subtreeWeights[index] = rootDistances[index] - lowerBound;
+			blocked[index] = isLandmark[index];
+			bestChildren[index] = INVALID_INDEX;
+		}
+
+		// children settle after their parent, so walking the settle order backwards finishes every subtree before its parent
+		for (auto iter = settleOrder.rbegin(); iter != settleOrder.rend(); ++iter)
+		{
+			const uint32_t index = *iter;
+			const uint32_t parent = workspace[index].previous;
+			if (parent == INVALID_INDEX) continue;
+
+			if (blocked[index])
+			{
+				blocked[parent] = true;
+				continue;
+			}
+			subtreeWeights[parent] += subtreeWeights[index];
+			if (bestChildren[parent] == INVALID_INDEX || subtreeWeights[index] > subtreeWeights[bestChildren[parent]]) bestChildren[parent] = index;
+		}
+
+		uint32_t current = root;
+		while (bestChildren[current] != INVALID_INDEX) current = bestChildren[current];
+		return isLandmark[current] ? pickFarthest() : current;
+	};
+
+	landmarks.clear();
+	while (landmarks.size() < min(count, candidates.size()))
+	{
+		const uint32_t landmark = selection == LandmarkSelection::Avoid ? pickAvoid() : pickFarthest();
+		if (landmark == INVALID_INDEX) break;
+
+		landmarks.push_back(landmark);
+		isLandmark[landmark] = true;
+
+		// the distances to the landmark are built on their own thread while the next landmarks are selected
+		backwardTables.push_back(async(launch::async, [&reverse, landmark]()
+		{
+			SearchWorkspace reverseWorkspace;
+			vector<float> distances;
+			computeDistances(reverse, landmark, reverseWorkspace, distances);
+			return distances;
+		}));
+
+		forwardTables.emplace_back();
+		computeDistances(graph, landmark, workspace, forwardTables.back());
+		for (size_t index = 0; index < indexCount; index++) minDistances[index] = min(minDistances[index], forwardTables.back()[index]);
+	}
+
+	// transpose into one row per node
+	const size_t landmarkCount = landmarks.size();
+	fromLandmarks.resize(indexCount * landmarkCount);
+	toLandmarks.resize(indexCount * landmarkCount);
+	for (size_t k = 0; k < landmarkCount; k++)
+	{
+		const vector<float> toLandmark = backwardTables[k].get();
+		for (size_t index = 0; index < indexCount; index++)
+		{
+			fromLandmarks[index * landmarkCount + k] = forwardTables[k][index];
+			toLandmarks[index * landmarkCount + k] = toLandmark[index];
+		}
+	}
+
+	preprocessingTime = high_resolution_clock().now() - startTime;
+}
+
+float Landmarks::estimate(const uint32_t from, const uint32_t to) const
+{
+	// nodes added after the tables were built are unknown to them
+	if (from >= indexCount || to >= indexCount) return 0;
+
+	// d(from, to) >= d(L, to) - d(L, from) and d(from, to) >= d(from, L) - d(to, L) for every landmark L
+	const size_t landmarkCount = landmarks.size();
+	const float* fromRow = fromLandmarks.data() + from * landmarkCount;
+	const float* toRow = fromLandmarks.data() + to * landmarkCount;
+	const float* fromReverseRow = toLandmarks.data() + from * landmarkCount;
+	const float* toReverseRow = toLandmarks.data() + to * landmarkCount;
+
+	float bound = 0;
+	for (size_t k = 0; k < landmarkCount; k++)
+	{
+		const float forwardBound = toRow[k] - fromRow[k];
+		const float backwardBound = fromReverseRow[k] - toReverseRow[k];
+		if (std::isfinite(forwardBound) && forwardBound > bound) bound = forwardBound;
+		if (std::isfinite(backwardBound) && backwardBound > bound) bound = backwardBound;
+	}
+	return bound;
+}
+
+bool Landmarks::isAdmissible(const Graph& graph) const
+{
+	// added nodes only get the trivial estimate, so the heuristic is no longer consistent
+	if (graph.getIndexCount() != indexCount) return false;
+
+	std::vector<EdgeChange> changes;
+	if (!graph.getChangesSince(graphVersion, changes)) return false;
+
+	return std::all_of(changes.begin(), changes.end(), [](const EdgeChange& change) { return change.weight >= change.previousWeight; });
+}
+
+std::function<float(const Graph& graph, const Node& current, const Node& target)> Landmarks::getHeuristic() const
+{
+	return [this](const Graph&, const Node& current, const Node& target) { return estimate(current.getIndex(), target.getIndex()); };
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include "CompactGraph.h"
+#include "ImplicitGridGraph.h"
+
+namespace Pathfinding
+{
+	enum class LandmarkSelection
+	{
+		Farthest,
+		Avoid
+	};
+
+	// ALT lower bounds, the triangle inequality over precomputed distances from and to a few landmarks bounds every distance
+	// farthest spreads the landmarks over the graph, avoid places them behind regions the current landmarks bound badly
+	class Landmarks
+	{
+		private:
+
+		size_t indexCount = 0;
+		std::vector<uint32_t> landmarks;
+
+		// rows are nodes and columns landmarks, so one estimate reads two contiguous rows per table
+		std::vector<float> fromLandmarks;
+		std::vector<float> toLandmarks;
+
+		std::chrono::nanoseconds preprocessingTime = std::chrono::nanoseconds::zero();
+		uint64_t graphVersion = 0;
+
+		template<typename GraphType, typename ReverseType>
+		void build(const GraphType& graph, const ReverseType& reverse, const size_t count, const LandmarkSelection selection, const unsigned int seed);
+
+		public:
+
+		Landmarks(const Graph& graph, const size_t count = 16, const LandmarkSelection selection = LandmarkSelection::Avoid, const unsigned int seed = 0);
+		Landmarks(const ImplicitGridGraph& graph, const size_t count = 16, const LandmarkSelection selection = LandmarkSelection::Avoid, const unsigned int seed = 0);
+
+		const std::vector<uint32_t>& getLandmarks() const { return landmarks; }
+		size_t getIndexCount() const { return indexCount; }
+		std::chrono::nanoseconds getPreprocessingTime() const { return preprocessingTime; }
+
+		// consistent lower bound of the path weight from -> to, unreachable landmarks do not contribute and nodes added afterwards get 0
+		float estimate(const uint32_t from, const uint32_t to) const;
+
+		// tables built from a graph stay lower bounds as long as its weights only grew since, any lowered weight or added node needs new landmarks
+		bool isAdmissible(const Graph& graph) const;
+
+		// heuristic for AStar::getHeuristic or BidirectionalAStar::getHeuristic, the landmarks have to outlive it
+		std::function<float(const Graph& graph, const Node& current, const Node& target)> getHeuristic() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "ManyToMany.h"
+#include <atomic>
+#include <thread>
+#include "SearchWorkspace.h"
+
+using namespace Pathfinding;
+
+// hands out the items one at a time to the threads, the calling thread takes part as thread 0
+template<typename Work>
+static void parallelFor(const size_t count, const size_t threadCount, const Work& work)
+{
+	std::atomic<size_t> next = 0;
+	auto run = [&](const size_t thread)
+	{
+		for (size_t item = next++; item < count; item = next++) work(thread, item);
+	};
+
+	std::vector<std::jthread> workers;
+	for (size_t thread = 1; thread < std::min(threadCount, count); thread++) workers.emplace_back(run, thread);
+	run(0);
+}
+
+// Dijkstra over one half of a contraction hierarchy, settle is called for every node that is not stalled by a higher ranked node
+template<typename Edges, typename StallEdges, typename Settle>
+static void searchUpwards(const Edges& getEdges, const StallEdges& getStallEdges, const size_t indexCount, const uint32_t source, SearchWorkspace& workspace, const Settle& settle)
+{
+	workspace.reset(indexCount);
+	auto& discovered = workspace.pathWeightHeap;
+	workspace.discover(source, INVALID_INDEX, 0);
+	discovered.push(source, 0);
+
+	while (!discovered.empty())
+	{
+		const uint32_t current = discovered.pop();
+		workspace[current].explored = true;
+
+		bool stalled = false;
+		for (const auto [neighbour, weight] : getStallEdges(current))
+		{
+			if (workspace.isKnown(neighbour) && workspace[neighbour].pathWeight + weight < workspace[current].pathWeight)
+			{
+				stalled = true;
+				break;
+			}
+		}
+		if (stalled) continue;
+
+		settle(current, workspace[current].pathWeight);
+		for (const auto [neighbour, weight] : getEdges(current))
+		{
+			const float neighbourPathWeight = workspace[current].pathWeight + weight;
+			if (!workspace.isKnown(neighbour))
+			{
+				workspace.discover(neighbour, current, neighbourPathWeight);
+				discovered.push(neighbour, neighbourPathWeight);
+			}
+			else if (!workspace[neighbour].explored && workspace[neighbour].pathWeight > neighbourPathWeight)
+			{
+				workspace[neighbour].previous = current;
+				workspace[neighbour].pathWeight = neighbourPathWeight;
+				discovered.decrease(neighbour, neighbourPathWeight);
+			}
+		}
+	}
+}
+
+ManyToMany::ManyToMany(const size_t threadCount) : threadCount(threadCount)
+{
+	if (this->threadCount == 0) this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+template<typename GraphType>
+DistanceTable ManyToMany::runIndexed(const GraphType& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+	const size_t indexCount = graph.getIndexCount();
+
+	DistanceTable table;
+	table.sourceCount = sources.size();
+	table.targetCount = targets.size();
+	table.distances.assign(sources.size() * targets.size(), numeric_limits<float>::infinity());
+
+	// targets may repeat, so every node lists the columns it fills in one flat array
+	vector<uint32_t> columnOffsets(indexCount + 1, 0);
+	for (const uint32_t target : targets) columnOffsets[(size_t)target + 1]++;
+	const size_t uniqueTargetCount = count_if(columnOffsets.begin() + 1, columnOffsets.end(), [](const uint32_t count) { return count > 0; });
+	for (size_t index = 0; index < indexCount; index++) columnOffsets[index + 1] += columnOffsets[index];
+
+	vector<uint32_t> columns(targets.size());
+	vector<uint32_t> nextColumn(columnOffsets.begin(), columnOffsets.end() - 1);
+	for (uint32_t column = 0; column < targets.size(); column++) columns[nextColumn[targets[column]]++] = column;
+
+	vector<SearchWorkspace> workspaces(threadCount);
+	parallelFor(sources.size(), threadCount, [&](const size_t thread, const size_t row)
+	{
+		SearchWorkspace& workspace = workspaces[thread];
+		float* distances = table.distances.data() + row * targets.size();
+		size_t remainingTargets = uniqueTargetCount;
+
+		workspace.reset(indexCount);
+		auto& discovered = workspace.pathWeightHeap;
+		workspace.discover(sources[row], INVALID_INDEX, 0);
+		discovered.push(sources[row], 0);
+
+		// the search ends as soon as the last target is settled instead of covering the whole graph
+		while (!discovered.empty() && remainingTargets > 0)
+		{
+			const uint32_t current = discovered.pop();
+			workspace[current].explored = true;
+
+			if (columnOffsets[current] != columnOffsets[(size_t)current + 1])
+			{
+				for (uint32_t i = columnOffsets[current]; i < columnOffsets[(size_t)current + 1]; i++) distances[columns[i]] = workspace[current].pathWeight;
+				remainingTargets--;
+			}
+
+			for (const auto [neighbour, weight] : graph.getEdges(current))
+			{
+				const float neighbourPathWeight = workspace[current].pathWeight + weight;
+				if (!workspace.isKnown(neighbour))
+				{
+					workspace.discover(neighbour, current, neighbourPathWeight);
+					discovered.push(neighbour, neighbourPathWeight);
+				}
+				else if (!workspace[neighbour].explored && workspace[neighbour].pathWeight > neighbourPathWeight)
+				{
+					workspace[neighbour].previous = current;
+					workspace[neighbour].pathWeight = neighbourPathWeight;
+					discovered.decrease(neighbour, neighbourPathWeight);
+				}
+			}
+		}
+	});
+
+	table.runtime = high_resolution_clock().now() - startTime;
+	return table;
+}
+
+DistanceTable ManyToMany::run(const Graph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const
+{
+	return runIndexed(graph, sources, targets);
+}
+
+DistanceTable ManyToMany::run(const CompactGraph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const
+{
+	return runIndexed(graph, sources, targets);
+}
+
+DistanceTable ManyToMany::run(const ImplicitGridGraph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const
+{
+	return runIndexed(graph, sources, targets);
+}
+
+DistanceTable ManyToMany::run(const ContractionHierarchy& hierarchy, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const
+{
+	using namespace std;
+	using namespace std::chrono;
+
+	const auto startTime = high_resolution_clock().now();
+	const size_t indexCount = hierarchy.getIndexCount();
+	auto getUpwardEdges = [&hierarchy](const uint32_t index) { return hierarchy.getUpwardEdges(index); };
+	auto getDownwardEdges = [&hierarchy](const uint32_t index) { return hierarchy.getDownwardEdges(index); };
+
+	DistanceTable table;
+	table.sourceCount = sources.size();
+	table.targetCount = targets.size();
+	table.distances.assign(sources.size() * targets.size(), numeric_limits<float>::infinity());
+
+	struct BucketEntry
+	{
+		uint32_t index;
+		uint32_t column;
+		float pathWeight;
+	};
+
+	// backward upward search of every target, each settled node remembers the target and the distance to it
+	vector<SearchWorkspace> workspaces(threadCount);
+	vector<vector<BucketEntry>> threadEntries(threadCount);
+	parallelFor(targets.size(), threadCount, [&](const size_t thread, const size_t column)
+	{
+		searchUpwards(getDownwardEdges, getUpwardEdges, indexCount, targets[column], workspaces[thread], [&](const uint32_t index, const float pathWeight)
+		{
+			threadEntries[thread].push_back({ index, (uint32_t)column, pathWeight });
+		});
+	});
+
+	// the buckets of all nodes are stored in one flat array
+	vector<uint32_t> bucketOffsets(indexCount + 1, 0);
+	for (const vector<BucketEntry>& entries : threadEntries)
+	{
+		for (const BucketEntry& entry : entries) bucketOffsets[(size_t)entry.index + 1]++;
+	}
+	for (size_t index = 0; index < indexCount; index++) bucketOffsets[index + 1] += bucketOffsets[index];
+
+	vector<pair<uint32_t, float>> buckets(bucketOffsets.back());
+	vector<uint32_t> nextEntry(bucketOffsets.begin(), bucketOffsets.end() - 1);
+	for (const vector<BucketEntry>& entries : threadEntries)
+	{
+		for (const BucketEntry& entry : entries) buckets[nextEntry[entry.index]++] = { entry.column, entry.pathWeight };
+	}
+	threadEntries.clear();
+
+	// forward upward search of every source, every path to a target meets its backward search at the highest ranked node of the path
+	parallelFor(sources.size(), threadCount, [&](const size_t thread, const size_t row)
+	{
+		float* distances = table.distances.data() + row * targets.size();
+		searchUpwards(getUpwardEdges, getDownwardEdges, indexCount, sources[row], workspaces[thread], [&](const uint32_t index, const float pathWeight)
+		{
+			for (uint32_t i = bucketOffsets[index]; i < bucketOffsets[(size_t)index + 1]; i++)
+			{
+				const auto [column, targetPathWeight] = buckets[i];
+				distances[column] = min(distances[column], pathWeight + targetPathWeight);
+			}
+		});
+	});
+
+	table.runtime = high_resolution_clock().now() - startTime;
+	return table;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "ContractionHierarchy.h"
+#include "DistanceField.h"
+
+namespace Pathfinding
+{
+	// distance tables between many sources and many targets, sources are searched in parallel and share one table
+	// on plain graphs every source runs a one-to-all Dijkstra that stops once all targets are settled
+	// on a contraction hierarchy the upward searches of all targets are stored in buckets, each source search then only scans buckets
+	class ManyToMany
+	{
+		private:
+
+		size_t threadCount;
+
+		template<typename GraphType>
+		DistanceTable runIndexed(const GraphType& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const;
+
+		public:
+
+		// no thread count uses every hardware thread
+		ManyToMany(const size_t threadCount = 0);
+
+		size_t getThreadCount() const { return threadCount; }
+
+		DistanceTable run(const Graph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const;
+		DistanceTable run(const CompactGraph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const;
+		DistanceTable run(const ImplicitGridGraph& graph, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const;
+		DistanceTable run(const ContractionHierarchy& hierarchy, const std::vector<uint32_t>& sources, const std::vector<uint32_t>& targets) const;
+	};
+}
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "Node.h"
+#include "Graph.h"
 
 using namespace Pathfinding;
 
-std::unique_ptr<Node> Node::create(const std::string name, std::vector<std::unique_ptr<Edge>>&& edges)
+std::unique_ptr<Node> Node::create(const std::string name, std::vector<Edge>&& edges)
 {
 	auto node = std::make_unique<Node>();
 	node->name = name;
@@ -11,34 +12,51 @@ std::unique_ptr<Node> Node::create(const std::string name, std::vector<std::uniq
 	return node;
 }
 
+Edge* Node::findEdge(const Node& neighbour)
+{
+	for (Edge& edge : this->edges)
+	{
+		if (edge.neighbour == &neighbour) return &edge;
+	}
+	return nullptr;
+}
+
 void Node::addEdge(const Node& neighbour, const float weight)
 {
 	// check if node is already contained
-	auto iter = std::find_if(this->edges.begin(), this->edges.end(), [&](auto& item) { return *item->neighbour == neighbour; });
-	if (iter != this->edges.end()) return;
+	if (findEdge(neighbour)) return;
 
 	// add new edge
-	this->edges.push_back(std::make_unique<Edge>(&neighbour, weight));
+	this->edges.push_back({ &neighbour, weight });
 }
 
 bool Node::removeEdge(const Node& neighbour)
 {
 	// try to remove element, if success return true, else return false
-	auto iter = std::find_if(this->edges.begin(), this->edges.end(), [&](auto& item) { return *item->neighbour == neighbour; });
-	if (iter == this->edges.end()) return false;
+	const Edge* edge = findEdge(neighbour);
+	if (!edge) return false;
 
-	this->edges.erase(iter);
+	this->edges.erase(this->edges.begin() + (edge - this->edges.data()));
 	return true;
 }
 
 void Node::setEdgeWeight(const Node& neighbour, const float weight)
 {
 	// find edge and change its weight
-	auto iter = std::find_if(this->edges.begin(), this->edges.end(), [&](auto& item) { return *item->neighbour == neighbour; });
-	if (iter != this->edges.end()) (*iter)->weight = weight;
+	Edge* edge = findEdge(neighbour);
+	if (edge) edge->weight = weight;
+}
+
+const std::string Node::getName() const
+{
+	// unnamed nodes of a graph get their name from the graph's naming scheme
+	if (!name.empty() || !graph || !graph->generateName) return name;
+	return graph->generateName(index);
 }
 
 bool Node::operator==(const Node& other) const
 {
-	return this->name == other.name;
+	// nodes of a graph are identified by their graph and index, loose nodes and nodes of different graphs fall back to their name
+	if (this->graph && this->graph == other.graph) return this->index == other.index;
+	return this->getName() == other.getName();
 }
\ No newline at end of file
@@ -1,36 +1,56 @@
 #pragma once
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace Pathfinding
 {
-	struct Edge;
+	constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+	class Graph;
+	class Node;
+
+	struct Edge
+	{
+		const Node* neighbour;
+		float weight;
+	};
+
+	struct IndexedEdge
+	{
+		const uint32_t neighbour;
+		const float weight;
+	};
 
 	class Node
 	{
+		friend class Graph;
+
 		private:
 
 		std::string name;
-		std::vector<std::unique_ptr<Edge>> edges;
+		std::vector<Edge> edges;
+		uint32_t index = INVALID_INDEX;
+		const Graph* graph = nullptr;
+
+		// edges are found by the address of their neighbour, so a node of another graph or a loose copy never matches and no names are compared
+		Edge* findEdge(const Node& neighbour);
 
 		public:
 
-		static std::unique_ptr<Node> create(const std::string name, std::vector<std::unique_ptr<Edge>>&& edges = {});
+		static std::unique_ptr<Node> create(const std::string name, std::vector<Edge>&& edges = {});
 		void addEdge(const Node& neighbour, const float weight);
 		bool removeEdge(const Node& neighbour);
 		void setEdgeWeight(const Node& neighbour, const float weight);
+		void reserveEdges(const size_t count) { edges.reserve(count); }
 
-		const std::vector<std::unique_ptr<Edge>>& getEdges() const { return edges; }
-		const std::string getName() const { return name; }
+		const std::vector<Edge>& getEdges() const { return edges; }
+		const std::string getName() const;
+		uint32_t getIndex() const { return index; }
 		~Node() { edges.clear(); }
 
 		bool operator==(const Node& other) const;
 	};
-
-	struct Edge
-	{
-		const Node* neighbour;
-		float weight;
-	};
 }
\ No newline at end of file
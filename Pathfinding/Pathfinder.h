@@ -1,7 +1,10 @@
 #pragma once
+#include <algorithm>
 #include <chrono>
 #include "Coroutine.h"
-#include "Graph.h"
+#include "CompactGraph.h"
+#include "ImplicitGridGraph.h"
+#include "SearchWorkspace.h"
 
 namespace Pathfinding
 {
@@ -20,6 +23,7 @@ namespace Pathfinding
 
 		PathData() {}
 		PathData(const Node* previousNode, float pathWeight) : previousNode(previousNode), pathWeight(pathWeight) {}
+		PathData(const Node* previousNode, const SearchWorkspace::Slot& slot) : PathData(previousNode, slot.pathWeight) {}
 		virtual ~PathData() {}
 	};
 
@@ -27,7 +31,7 @@ namespace Pathfinding
 	{
 		const Node* const node;
 		const NodeState state;
-		const PathData& pathData;
+		const std::shared_ptr<const PathData> pathData;
 	};
 
 	struct SearchResult
@@ -35,23 +39,82 @@ namespace Pathfinding
 		const bool pathFound = false;
 		const float pathWeight = 0;
 		const std::list<const Node*> path;
+		const std::vector<uint32_t> indexPath;
 
 		const size_t nodesExplored = 0;
 		const std::chrono::nanoseconds runtime = std::chrono::nanoseconds::zero();
 
 		SearchResult() {}
 		SearchResult(const size_t nodesExplored, const std::chrono::nanoseconds runtime) : nodesExplored(nodesExplored), runtime(runtime) {}
-		SearchResult(const bool pathFound, const float pathWeight, std::list<const Node*>&& path, const size_t nodesExplored, const std::chrono::nanoseconds runtime)
-			: pathFound(pathFound), pathWeight(pathWeight), path(move(path)), nodesExplored(nodesExplored), runtime(runtime) {}
+		SearchResult(const bool pathFound, const float pathWeight, std::list<const Node*>&& path, std::vector<uint32_t>&& indexPath, const size_t nodesExplored, const std::chrono::nanoseconds runtime)
+			: pathFound(pathFound), pathWeight(pathWeight), path(move(path)), indexPath(move(indexPath)), nodesExplored(nodesExplored), runtime(runtime) {}
+	};
+
+	// graphs built from a grid layout share its weights until their own weights are changed, searches reading weights from the layout need this
+	// versions created from a compact graph never have the weights of the layout, even if their source graph still has
+	inline bool hasLayoutWeights(const Graph& graph) { return graph.getVersion() == 0; }
+	inline bool hasLayoutWeights(const CompactGraph& graph) { return graph.getVersion() == 0 && graph.getSnapshotVersion() == 0; }
+
+	// records every search step into a search log for visualisation
+	template<typename PathDataType>
+	struct SearchRecorder
+	{
+		std::list<SearchData>& searchLog;
+
+		template<typename GraphType>
+		void operator()(const GraphType& graph, const SearchWorkspace& workspace, const uint32_t index, const NodeState state) const
+		{
+			const auto& slot = workspace[index];
+			const Node* previousNode = slot.previous != INVALID_INDEX ? graph.nodeAt(slot.previous) : nullptr;
+			searchLog.push_back({ graph.nodeAt(index), state, std::make_shared<PathDataType>(previousNode, slot) });
+		}
+	};
+
+	// used by headless searches, compiles down to nothing
+	struct NullRecorder
+	{
+		template<typename GraphType>
+		void operator()(const GraphType&, const SearchWorkspace&, const uint32_t, const NodeState) const {}
 	};
 
 	class Pathfinder
 	{
+		protected:
+
+		// walks back from the end node, graphs without Node objects only get an index path
+		template<typename GraphType>
+		SearchResult buildResult(const GraphType& graph, const SearchWorkspace& workspace, const uint32_t end, const size_t nodesExplored, const std::chrono::nanoseconds runtime) const
+		{
+			std::vector<uint32_t> indexPath;
+			for (uint32_t current = end; current != INVALID_INDEX; current = workspace[current].previous)
+			{
+				indexPath.push_back(current);
+			}
+			std::reverse(indexPath.begin(), indexPath.end());
+
+			std::list<const Node*> path;
+			if constexpr (requires { graph.nodeAt(end); })
+			{
+				for (const uint32_t index : indexPath) path.push_back(graph.nodeAt(index));
+			}
+
+			return SearchResult(true, workspace[end].pathWeight, move(path), move(indexPath), nodesExplored, runtime);
+		}
+
 		public:
 
 		std::list<SearchData> searchLog;
 		std::shared_ptr<SearchResult> searchResult;
 
-		virtual Coroutine search(const Graph& graph, const Node& start, const Node& end, bool& incrementalSearch) = 0;
+		// the workspace is owned by the caller and has to outlive the returned coroutine, only one search may use it at a time
+		virtual Coroutine search(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) = 0;
+		virtual Coroutine search(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace, bool& incrementalSearch) = 0;
+
+		// runs the same search to completion without suspending, logging or touching searchLog and searchResult
+		virtual SearchResult runSync(const Graph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const = 0;
+		virtual SearchResult runSync(const CompactGraph& graph, const Node& start, const Node& end, SearchWorkspace& workspace) const = 0;
+
+		// implicit grids have no nodes to visualise, so they can only be searched headless by index
+		virtual SearchResult runSync(const ImplicitGridGraph& graph, const uint32_t start, const uint32_t end, SearchWorkspace& workspace) const = 0;
 	};
 }
\ No newline at end of file
@@ -15,11 +15,12 @@ int main(int argc, char* argv[])
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) return -1;
     SDL_Window* window = SDL_CreateWindow("Pathfinding.exe", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1000, 1000, SDL_WINDOW_RESIZABLE);
 
-    unique_ptr<Environment> environment ( (Environment*) new Grid(15, 15, window) );
+    const auto gridGraph = GridGraphBuilder(15, 15, (unsigned int)time(NULL)).build();
+    unique_ptr<Environment> environment ( (Environment*) new Grid(gridGraph, window) );
     unique_ptr<Pathfinder> pathfinder;
 
-    auto& startNode = environment->getGraph()->getNode(Grid::generateNodeName(0, 0));
-    auto& endNode = environment->getGraph()->getNode(Grid::generateNodeName(14, 14));
+    auto& startNode = environment->getGraph()->getNode(GridGraphBuilder::generateNodeName(0, 0));
+    auto& endNode = environment->getGraph()->getNode(GridGraphBuilder::generateNodeName(14, 14));
 
 
     auto pushAutoPlayEvent = [](Uint32 _, void* params)
@@ -89,6 +90,42 @@ int main(int argc, char* argv[])
                         environment->searchInitialize(move(pathfinder), *startNode, *endNode);
                         break;
 
+                    case SDLK_5:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new BidirectionalDijkstra());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
+                    case SDLK_6:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new BidirectionalAStar());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
+                    case SDLK_7:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new JumpPointSearch());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
+                    case SDLK_8:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new JumpPointSearchPlus());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
+                    case SDLK_9:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new HierarchicalAStar());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
+                    case SDLK_0:
+                        autoPlay = false;
+                        pathfinder = unique_ptr<Pathfinder>((Pathfinder*) new ContractionHierarchySearch());
+                        environment->searchInitialize(move(pathfinder), *startNode, *endNode);
+                        break;
+
                     case SDLK_BACKSPACE:
                         autoPlay = false;
                         // pathfinder is empty, this is by design
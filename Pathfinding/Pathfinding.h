@@ -5,6 +5,19 @@
 #include "BreadthFirst.h"
 #include "Dijkstra.h"
 #include "AStar.h"
+#include "BidirectionalDijkstra.h"
+#include "BidirectionalAStar.h"
+#include "JumpPointSearch.h"
+#include "JumpPointSearchPlus.h"
+#include "HierarchicalAStar.h"
+#include "ContractionHierarchySearch.h"
+#include "Landmarks.h"
+#include "DeltaStepping.h"
+#include "ManyToMany.h"
+#include "DStarLite.h"
+#include "QueryService.h"
+#include "BatchScheduler.h"
+#include "GraphSnapshots.h"
 
 // environments
 #include "Grid.h"
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "QueryService.h"
+#include <latch>
+
+using namespace Pathfinding;
+
+QueryService::QueryService(const Pathfinder& pathfinder, const Graph& graph, const size_t threadCount)
+{
+	query = [&pathfinder, &graph](const uint32_t start, const uint32_t end, SearchWorkspace& workspace) { return pathfinder.runSync(graph, *graph.nodeAt(start), *graph.nodeAt(end), workspace); };
+	this->start(threadCount);
+}
+
+QueryService::QueryService(const Pathfinder& pathfinder, const CompactGraph& graph, const size_t threadCount)
+{
+	query = [&pathfinder, &graph](const uint32_t start, const uint32_t end, SearchWorkspace& workspace) { return pathfinder.runSync(graph, *graph.nodeAt(start), *graph.nodeAt(end), workspace); };
+	this->start(threadCount);
+}
+
+QueryService::QueryService(const Pathfinder& pathfinder, const GraphSnapshots& snapshots, const size_t threadCount)
+{
+	// every query pins the newest version once, so it searches consistent weights even if a writer publishes meanwhile
+	query = [&pathfinder, &snapshots](const uint32_t start, const uint32_t end, SearchWorkspace& workspace)
+	{
+		const std::shared_ptr<const CompactGraph> graph = snapshots.pin();
+		return pathfinder.runSync(*graph, *graph->nodeAt(start), *graph->nodeAt(end), workspace);
+	};
+	this->start(threadCount);
+}
+
+QueryService::QueryService(const Pathfinder& pathfinder, const ImplicitGridGraph& graph, const size_t threadCount)
+{
+	query = [&pathfinder, &graph](const uint32_t start, const uint32_t end, SearchWorkspace& workspace) { return pathfinder.runSync(graph, start, end, workspace); };
+	this->start(threadCount);
+}
+
+void QueryService::start(const size_t threadCount)
+{
+	const size_t workerCount = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+	// workspaces are created before any worker runs, so their addresses stay fixed
+	workspaces.resize(workerCount);
+	for (size_t thread = 0; thread < workerCount; thread++)
+	{
+		workers.emplace_back([this, thread](std::stop_token stopToken) { work(stopToken, thread); });
+	}
+}
+
+void QueryService::enqueue(Job&& job)
+{
+	{
+		std::lock_guard lock(jobMutex);
+		jobs.push_back(move(job));
+	}
+	jobAdded.notify_one();
+}
+
+void QueryService::work(std::stop_token stopToken, const size_t thread)
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock lock(jobMutex);
+			if (!jobAdded.wait(lock, stopToken, [this]() { return !jobs.empty(); })) return;
+
+			job = move(jobs.front());
+			jobs.pop_front();
+		}
+		job(workspaces[thread]);
+	}
+}
+
+std::future<SearchResult> QueryService::submit(const uint32_t start, const uint32_t end)
+{
+	// jobs have to be copyable, so the task is shared with the job running it
+	auto task = std::make_shared<std::packaged_task<SearchResult(SearchWorkspace&)>>([this, start, end](SearchWorkspace& workspace) { return query(start, end, workspace); });
+	std::future<SearchResult> result = task->get_future();
+	enqueue([task](SearchWorkspace& workspace) { (*task)(workspace); });
+	return result;
+}
+
+std::vector<SearchResult> QueryService::runBatch(const std::vector<PathQuery>& queries)
+{
+	using namespace std;
+
+	// every worker takes the next unanswered query until none are left, so no query waits behind a slow one of another worker
+	vector<optional<SearchResult>> answers(queries.size());
+	atomic<size_t> next = 0;
+	exception_ptr error;
+	mutex errorMutex;
+	latch finished((ptrdiff_t)workers.size());
+
+	for (size_t worker = 0; worker < workers.size(); worker++)
+	{
+		enqueue([&](SearchWorkspace& workspace)
+		{
+			try
+			{
+				for (size_t i = next++; i < queries.size(); i = next++) answers[i].emplace(query(queries[i].start, queries[i].end, workspace));
+			}
+			catch (...)
+			{
+				// the first failure stops the batch, the other workers finish their current query
+				lock_guard lock(errorMutex);
+				if (!error) error = current_exception();
+				next = queries.size();
+			}
+			finished.count_down();
+		});
+	}
+	finished.wait();
+	if (error) rethrow_exception(error);
+
+	vector<SearchResult> results;
+	results.reserve(queries.size());
+	for (optional<SearchResult>& answer : answers) results.push_back(move(*answer));
+	return results;
+}
\ No newline at end of file
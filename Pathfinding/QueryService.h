@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include "GraphSnapshots.h"
+#include "Pathfinder.h"
+
+namespace Pathfinding
+{
+	struct PathQuery
+	{
+		uint32_t start;
+		uint32_t end;
+	};
+
+	// answers queries of many callers at once on a pool of worker threads, every worker owns its workspace
+	// only runSync of the pathfinder is used, so neither the pathfinder nor the graph are written while queries run
+	// both have to outlive the service and must not be changed while it has queries in flight, weights that change are published through snapshots
+	// searches that cache data per graph have to be prepared before, like BidirectionalSearch::prepareReverseGraph, or every query builds its own
+	class QueryService
+	{
+		private:
+
+		using Job = std::function<void(SearchWorkspace& workspace)>;
+
+		std::function<SearchResult(const uint32_t start, const uint32_t end, SearchWorkspace& workspace)> query;
+		std::vector<SearchWorkspace> workspaces;
+
+		std::mutex jobMutex;
+		std::condition_variable_any jobAdded;
+		std::deque<Job> jobs;
+
+		// destroyed first, so the workers stop before the queue they wait on is gone
+		std::vector<std::jthread> workers;
+
+		void start(const size_t threadCount);
+		void enqueue(Job&& job);
+		void work(std::stop_token stopToken, const size_t thread);
+
+		public:
+
+		// no thread count uses every hardware thread
+		QueryService(const Pathfinder& pathfinder, const Graph& graph, const size_t threadCount = 0);
+		QueryService(const Pathfinder& pathfinder, const CompactGraph& graph, const size_t threadCount = 0);
+		QueryService(const Pathfinder& pathfinder, const ImplicitGridGraph& graph, const size_t threadCount = 0);
+
+		// weights may change while queries run, every query searches the version that was newest when it started
+		// searches taking their weights from a grid layout, like JumpPointSearch, HierarchicalAStar and DStarLite, refuse every later version
+		QueryService(const Pathfinder& pathfinder, const GraphSnapshots& snapshots, const size_t threadCount = 0);
+
+		size_t getThreadCount() const { return workers.size(); }
+
+		// exceptions of the search are rethrown by the future, queries still queued when the service is destroyed report a broken promise
+		std::future<SearchResult> submit(const uint32_t start, const uint32_t end);
+
+		// spreads the queries over all workers and waits for them, results are in the order of the queries
+		// must not be called from inside a query of the same service, the calling worker would wait on itself
+		std::vector<SearchResult> runBatch(const std::vector<PathQuery>& queries);
+	};
+}
\ No newline at end of file
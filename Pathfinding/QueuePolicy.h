@@ -0,0 +1,38 @@
+#pragma once
+#include <optional>
+#include "CompactGraph.h"
+#include "ImplicitGridGraph.h"
+
+namespace Pathfinding
+{
+	// priority queue of a search, automatic picks a bucket queue or radix heap whenever the graph guarantees bounded integer weights
+	enum class QueuePolicy
+	{
+		Automatic,
+		BinaryHeap,
+		Bucket,
+		Radix
+	};
+
+	// bucket queues need one bucket per possible weight, larger weights are left to the heaps
+	constexpr uint32_t MAX_BUCKET_WEIGHT = 1 << 12;
+
+	// largest edge weight of graphs whose weights are all integers, pointer graphs can change at any time and are never bounded
+	inline std::optional<uint32_t> getIntegerWeightBound(const Graph&)
+	{
+		return std::nullopt;
+	}
+
+	inline std::optional<uint32_t> getIntegerWeightBound(const CompactGraph& graph)
+	{
+		if (!graph.hasIntegerWeights() || graph.getMaxWeight() > MAX_BUCKET_WEIGHT) return std::nullopt;
+		return (uint32_t)graph.getMaxWeight();
+	}
+
+	inline std::optional<uint32_t> getIntegerWeightBound(const ImplicitGridGraph& graph)
+	{
+		// heights range from 0 to HEIGHTMAP_STEPS, diagonal steps are never integers
+		if (graph.getConnectivity() != GridConnectivity::FourNeighbours) return std::nullopt;
+		return (uint32_t)ImplicitGridGraph::getEdgeWeight(0, HEIGHTMAP_STEPS);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+#include <array>
+#include <bit>
+#include "IndexedHeap.h"
+
+namespace Pathfinding
+{
+	// radix heap over node indices, non-negative float keys order like their bit patterns so any monotone search runs in amortised constant time
+	// entries are spread over buckets by the highest bit in which they differ from the last popped key
+	// keys below the last popped key, like reopened nodes of an inconsistent heuristic, wait in a binary heap that is always popped first
+	template<typename Key>
+	class RadixHeap
+	{
+		private:
+
+		struct Entry
+		{
+			uint64_t radixKey;
+			Key key;
+			uint32_t index;
+		};
+
+		struct Position
+		{
+			uint32_t bucket;
+			uint32_t slot;
+		};
+
+		mutable std::array<std::vector<Entry>, 65> buckets;
+		mutable std::vector<Entry> redistributed;
+		mutable std::vector<Position> positions;
+		mutable uint64_t last = 0;
+		size_t count = 0;
+		IndexedHeap<Key> underflow;
+
+		static uint64_t toRadixKey(const float key) { return std::bit_cast<uint32_t>(key); }
+		static uint64_t toRadixKey(const std::pair<float, float>& key) { return ((uint64_t)std::bit_cast<uint32_t>(key.first) << 32) | std::bit_cast<uint32_t>(key.second); }
+
+		void place(const Entry& entry) const
+		{
+			const uint32_t bucket = entry.radixKey == last ? 0 : 64 - std::countl_zero(entry.radixKey ^ last);
+			positions[entry.index] = { bucket, (uint32_t)buckets[bucket].size() };
+			buckets[bucket].push_back(entry);
+		}
+
+		// makes the smallest key the last one, all entries carrying it end up in the first bucket
+		void refill() const
+		{
+			if (!buckets[0].empty()) return;
+
+			size_t bucket = 1;
+			while (buckets[bucket].empty()) bucket++;
+
+			last = buckets[bucket][0].radixKey;
+			for (const Entry& entry : buckets[bucket]) last = std::min(last, entry.radixKey);
+
+			redistributed.swap(buckets[bucket]);
+			for (const Entry& entry : redistributed) place(entry);
+			redistributed.clear();
+		}
+
+		void remove(const uint32_t index)
+		{
+			std::vector<Entry>& bucket = buckets[positions[index].bucket];
+			const uint32_t slot = positions[index].slot;
+			bucket[slot] = bucket.back();
+			positions[bucket[slot].index].slot = slot;
+			bucket.pop_back();
+			count--;
+		}
+
+		public:
+
+		// positions are not cleared, an index only counts as contained if its bucket slot points back at it
+		void reset(const size_t indexCount)
+		{
+			for (std::vector<Entry>& bucket : buckets) bucket.clear();
+			if (positions.size() < indexCount) positions.resize(indexCount);
+			last = 0;
+			count = 0;
+			underflow.reset(indexCount);
+		}
+
+		bool empty() const { return count == 0 && underflow.empty(); }
+		size_t size() const { return count + underflow.size(); }
+
+		const Key& topKey() const
+		{
+			if (!underflow.empty()) return underflow.topKey();
+
+			refill();
+			return buckets[0].back().key;
+		}
+
+		bool contains(const uint32_t index) const
+		{
+			if (index >= positions.size()) return false;
+
+			const Position position = positions[index];
+			if (position.bucket < buckets.size() && position.slot < buckets[position.bucket].size() && buckets[position.bucket][position.slot].index == index) return true;
+			return underflow.contains(index);
+		}
+
+		void push(const uint32_t index, const Key& key)
+		{
+			const uint64_t radixKey = toRadixKey(key);
+			if (radixKey < last)
+			{
+				underflow.push(index, key);
+				return;
+			}
+
+			place({ radixKey, key, index });
+			count++;
+		}
+
+		void decrease(const uint32_t index, const Key& key)
+		{
+			if (underflow.contains(index))
+			{
+				underflow.decrease(index, key);
+				return;
+			}
+
+			remove(index);
+			push(index, key);
+		}
+
+		void pushOrDecrease(const uint32_t index, const Key& key)
+		{
+			if (contains(index)) decrease(index, key);
+			else push(index, key);
+		}
+
+		uint32_t pop()
+		{
+			if (!underflow.empty()) return underflow.pop();
+
+			refill();
+			const uint32_t index = buckets[0].back().index;
+			buckets[0].pop_back();
+			count--;
+			return index;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "SearchWorkspace.h"
+
+using namespace Pathfinding;
+
+void SearchWorkspace::reset(const size_t indexCount)
+{
+	// grow to the graph, slots are never shrunk so the workspace can be shared between graphs
+	if (slots.size() < indexCount) slots.resize(indexCount);
+	frontier.clear();
+	pathWeightHeap.reset(indexCount);
+	estimateHeap.reset(indexCount);
+
+	// stamps of old queries could collide after an overflow, so wipe them once
+	if (++generation == 0)
+	{
+		for (Slot& slot : slots) slot.generation = 0;
+		generation = 1;
+	}
+}
+
+SearchWorkspace::Slot& SearchWorkspace::discover(const uint32_t index, const uint32_t previous, const float pathWeight, const float heuristicValue)
+{
+	Slot& slot = slots[index];
+	slot = { generation, previous, pathWeight, heuristicValue, false };
+	return slot;
+}
+
+SearchWorkspace& SearchWorkspace::getBackward()
+{
+	if (!backward) backward = std::make_unique<SearchWorkspace>();
+	return *backward;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+#include <utility>
+#include "BucketQueue.h"
+#include "IndexedHeap.h"
+#include "Node.h"
+#include "RadixHeap.h"
+
+namespace Pathfinding
+{
+	// search state that is reused between queries, a slot only belongs to the current query if it carries the current generation
+	class SearchWorkspace
+	{
+		public:
+
+		struct Slot
+		{
+			uint32_t generation = 0;
+			uint32_t previous = INVALID_INDEX;
+			float pathWeight = 0;
+			float heuristicValue = 0;
+			bool explored = false;
+		};
+
+		private:
+
+		uint32_t generation = 0;
+		std::vector<Slot> slots;
+		std::unique_ptr<SearchWorkspace> backward;
+
+		public:
+
+		std::vector<uint32_t> frontier;
+		IndexedHeap<float> pathWeightHeap;
+		IndexedHeap<std::pair<float, float>> estimateHeap;
+
+		// only reset by the searches choosing them, so workspaces that never use them stay small
+		BucketQueue pathWeightBuckets;
+		RadixHeap<float> pathWeightRadixHeap;
+		RadixHeap<std::pair<float, float>> estimateRadixHeap;
+
+		void reset(const size_t indexCount);
+		Slot& discover(const uint32_t index, const uint32_t previous, const float pathWeight, const float heuristicValue = 0);
+
+		bool isKnown(const uint32_t index) const { return slots[index].generation == generation; }
+		bool isExplored(const uint32_t index) const { return isKnown(index) && slots[index].explored; }
+		size_t size() const { return slots.size(); }
+
+		// second workspace for the search growing from the end node of bidirectional searches, created on first use
+		SearchWorkspace& getBackward();
+
+		Slot& operator[](const uint32_t index) { return slots[index]; }
+		const Slot& operator[](const uint32_t index) const { return slots[index]; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace Pathfinding
+{
+	// set of end nodes as a bitset over the dense node indices, searches given a set stop at the first target they settle
+	class TargetSet
+	{
+		private:
+
+		std::vector<uint64_t> words;
+		size_t count = 0;
+
+		public:
+
+		TargetSet(const size_t indexCount = 0) : words((indexCount + 63) / 64, 0) {}
+
+		void insert(const uint32_t index)
+		{
+			if ((size_t)index / 64 >= words.size()) words.resize((size_t)index / 64 + 1, 0);
+
+			uint64_t& word = words[index / 64];
+			const uint64_t bit = (uint64_t)1 << (index % 64);
+			if (!(word & bit)) count++;
+			word |= bit;
+		}
+
+		void erase(const uint32_t index)
+		{
+			if ((size_t)index / 64 >= words.size()) return;
+
+			uint64_t& word = words[index / 64];
+			const uint64_t bit = (uint64_t)1 << (index % 64);
+			if (word & bit) count--;
+			word &= ~bit;
+		}
+
+		void clear()
+		{
+			std::fill(words.begin(), words.end(), 0);
+			count = 0;
+		}
+
+		bool contains(const uint32_t index) const { return (size_t)index / 64 < words.size() && (words[index / 64] >> (index % 64) & 1); }
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+
+		// set bits in ascending order
+		std::vector<uint32_t> getIndices() const
+		{
+			std::vector<uint32_t> indices;
+			indices.reserve(count);
+			for (size_t i = 0; i < words.size(); i++)
+			{
+				for (uint64_t word = words[i]; word != 0; word &= word - 1) indices.push_back((uint32_t)(i * 64 + std::countr_zero(word)));
+			}
+			return indices;
+		}
+	};
+
+	// a single end node seen as a target set, so single and multi-target searches share their code
+	struct SingleTarget
+	{
+		uint32_t index;
+
+		bool contains(const uint32_t other) const { return other == index; }
+	};
+}
\ No newline at end of file